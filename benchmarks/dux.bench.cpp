@@ -0,0 +1,732 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <ferrugo/dux/dux.hpp>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#endif
+
+using namespace ferrugo;
+
+namespace
+{
+
+auto make_input(std::int64_t size) -> std::vector<int>
+{
+    std::vector<int> result(static_cast<std::size_t>(size));
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+}
+
+auto make_words(std::int64_t size) -> std::vector<std::string>
+{
+    std::vector<std::string> result;
+    result.reserve(static_cast<std::size_t>(size));
+    for (std::int64_t i = 0; i < size; ++i)
+    {
+        result.push_back(std::to_string(i));
+    }
+    return result;
+}
+
+template <class Func>
+void run(benchmark::State& state, Func func)
+{
+    const std::vector<int> in = make_input(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(func(in));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+constexpr inline auto is_even = [](int x) { return x % 2 == 0; };
+constexpr inline auto is_even_i = [](std::ptrdiff_t i, int) { return i % 2 == 0; };
+constexpr inline auto add_one = [](int x) { return x + 1; };
+constexpr inline auto add_index = [](std::ptrdiff_t i, int x) { return x + static_cast<int>(i); };
+constexpr inline auto less_than_half = [](int x) { return x < 1 << 30; };
+constexpr inline auto sum_reducer = [](std::int64_t total, int x) { return total + x; };
+
+}  // namespace
+
+// Baselines
+
+void reduce_hand_written_loop(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            std::int64_t total = 0;
+            for (int x : in)
+            {
+                total += x;
+            }
+            return total;
+        });
+}
+
+void reduce_dux(benchmark::State& state)
+{
+    run(state, [](const std::vector<int>& in) { return dux::reduce(std::int64_t{ 0 }, sum_reducer)(in); });
+}
+
+void reduce_dux_simd(benchmark::State& state)
+{
+    run(state, [](const std::vector<int>& in) { return dux::reduce(0, std::plus{})(in); });
+}
+
+void reduce_double_hand_written_loop(benchmark::State& state)
+{
+    const std::vector<int> ints = make_input(state.range(0));
+    const std::vector<double> in(ints.begin(), ints.end());
+    for (auto _ : state)
+    {
+        double total = 0.0;
+        for (double x : in)
+        {
+            total += x;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void reduce_double_dux_simd(benchmark::State& state)
+{
+    const std::vector<int> ints = make_input(state.range(0));
+    const std::vector<double> in(ints.begin(), ints.end());
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dux::reduce(0.0, std::plus{})(in));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void parallel_reduce_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in) { return dux::parallel_reduce(std::int64_t{ 0 }, sum_reducer, std::plus{})(in); });
+}
+
+// Transducers
+
+void transform_hand_written_loop(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            std::int64_t total = 0;
+            for (int x : in)
+            {
+                total += add_one(x);
+            }
+            return total;
+        });
+}
+
+void transform_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::transform(add_one) | sum_reducer)(in); });
+}
+
+void transform_i_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::transform_i(add_index) | sum_reducer)(in); });
+}
+
+void transform_maybe_dux(benchmark::State& state)
+{
+    const auto func = [](int x) { return is_even(x) ? std::optional<int>{ x } : std::optional<int>{}; };
+    run(state,
+        [&](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::transform_maybe(func) | sum_reducer)(in); });
+}
+
+void filter_hand_written_loop(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            std::int64_t total = 0;
+            for (int x : in)
+            {
+                if (is_even(x))
+                {
+                    total += x;
+                }
+            }
+            return total;
+        });
+}
+
+void filter_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in) { return dux::reduce(std::int64_t{ 0 }, dux::filter(is_even) | sum_reducer)(in); });
+}
+
+void filter_i_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::filter_i(is_even_i) | sum_reducer)(in); });
+}
+
+void inspect_dux(benchmark::State& state)
+{
+    std::int64_t count = 0;
+    run(state,
+        [&](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::inspect([&](int) { ++count; }) | sum_reducer)(in); });
+    benchmark::DoNotOptimize(count);
+}
+
+void inspect_i_dux(benchmark::State& state)
+{
+    std::int64_t count = 0;
+    const auto func = [&](std::ptrdiff_t i, int) { count += i; };
+    run(state,
+        [&](const std::vector<int>& in) { return dux::reduce(std::int64_t{ 0 }, dux::inspect_i(func) | sum_reducer)(in); });
+    benchmark::DoNotOptimize(count);
+}
+
+void take_dux(benchmark::State& state)
+{
+    run(state,
+        [&](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::take(state.range(0) / 2) | sum_reducer)(in); });
+}
+
+void drop_dux(benchmark::State& state)
+{
+    run(state,
+        [&](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::drop(state.range(0) / 2) | sum_reducer)(in); });
+}
+
+void take_while_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::take_while(less_than_half) | sum_reducer)(in); });
+}
+
+void drop_while_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::drop_while(std::not_fn(less_than_half)) | sum_reducer)(in); });
+}
+
+void stride_dux(benchmark::State& state)
+{
+    run(state, [](const std::vector<int>& in) { return dux::reduce(std::int64_t{ 0 }, dux::stride(3) | sum_reducer)(in); });
+}
+
+void intersperse_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in) { return dux::reduce(std::int64_t{ 0 }, dux::intersperse(-1) | sum_reducer)(in); });
+}
+
+void chunk_dux(benchmark::State& state)
+{
+    const auto sum_chunk = [](std::int64_t total, dux::span_t<const int> chunk)
+    {
+        for (int x : chunk)
+        {
+            total += x;
+        }
+        return total;
+    };
+    run(state,
+        [&](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::chunk<int>(256) | sum_chunk)(in); });
+}
+
+void chunk_arena_dux(benchmark::State& state)
+{
+    const auto sum_chunk = [](std::int64_t total, dux::span_t<const int> chunk)
+    {
+        for (int x : chunk)
+        {
+            total += x;
+        }
+        return total;
+    };
+    dux::arena arena{ 4096 };
+    run(state,
+        [&](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::chunk<int>(256) | sum_chunk, arena)(in); });
+}
+
+template <std::size_t Size>
+void window_max_rereduce(benchmark::State& state)
+{
+    const auto max = [](int lhs, int rhs) { return std::max(lhs, rhs); };
+    run(state,
+        [&](const std::vector<int>& in)
+        {
+            std::int64_t total = 0;
+            for (std::size_t i = Size; i <= in.size(); ++i)
+            {
+                const dux::span_t<const int> window{ in.data() + i - Size, Size };
+                total += dux::reduce(std::numeric_limits<int>::min(), max)(window);
+            }
+            return total;
+        });
+}
+
+template <std::size_t Size>
+void window_max_dux(benchmark::State& state)
+{
+    const auto max = [](int lhs, int rhs) { return std::max(lhs, rhs); };
+    run(state,
+        [&](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::window<int>(Size, max) | sum_reducer)(in); });
+}
+
+constexpr inline auto group_key = [](int x) { return static_cast<int>((x * 2654435761u) % 65536u); };
+
+void group_by_unordered_map(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            std::unordered_map<int, std::int64_t> groups;
+            for (int x : in)
+            {
+                groups[group_key(x)] += x;
+            }
+            return groups.size();
+        });
+}
+
+void group_by_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            return dux::reduce(
+                       dux::flat_map<int, std::int64_t>{},
+                       dux::group_by(group_key, std::int64_t{ 0 }, std::plus<>{}))(in)
+                .size();
+        });
+}
+
+void distinct_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        { return dux::reduce(std::int64_t{ 0 }, dux::distinct<int>(group_key) | sum_reducer)(in); });
+}
+
+void distinct_bloom_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            return dux::reduce(
+                std::int64_t{ 0 }, dux::distinct<int>(dux::bloom_options{ 65536, 0.01 }, group_key) | sum_reducer)(in);
+        });
+}
+
+void top_k_partial_sort(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            std::vector<int> all = dux::into(std::vector<int>{}, dux::transform(group_key), in);
+            const std::size_t count = std::min<std::size_t>(100, all.size());
+            std::partial_sort(all.begin(), all.begin() + count, all.end(), std::greater<>{});
+            all.resize(count);
+            return all;
+        });
+}
+
+void top_k_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        { return dux::reduce(std::vector<int>{}, dux::transform(group_key) | dux::top_k(100))(in); });
+}
+
+void sort_std(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            std::vector<int> all = dux::into(std::vector<int>{}, dux::transform(group_key), in);
+            std::sort(all.begin(), all.end());
+            return all;
+        });
+}
+
+void sort_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        { return dux::into(std::vector<int>{}, dux::transform(group_key) | dux::sort<int>(), in); });
+}
+
+// Budget of a quarter of a million items, so that the larger inputs are spilled in runs and merged.
+void sort_spill_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            const dux::sort_options options{ std::size_t{ 1 } << 20 };
+            return dux::into(std::vector<int>{}, dux::transform(group_key) | dux::sort<int>(options), in);
+        });
+}
+
+void join_hand_written_loop(benchmark::State& state)
+{
+    const std::vector<std::string> in = make_words(state.range(0));
+    for (auto _ : state)
+    {
+        std::string result;
+        for (const std::string& word : in)
+        {
+            result += word;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void join_dux(benchmark::State& state)
+{
+    const std::vector<std::string> in = make_words(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dux::into(std::string{}, dux::join, in));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void join_with_dux(benchmark::State& state)
+{
+    using namespace std::string_view_literals;
+    const std::vector<std::string> in = make_words(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dux::into(std::string{}, dux::join_with(", "sv), in));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Composition
+
+template <std::size_t... I>
+auto make_chain(std::index_sequence<I...>)
+{
+    return dux::compose(((void)I, dux::transform(add_one))...);
+}
+
+template <std::size_t Depth>
+void compose_dux(benchmark::State& state)
+{
+    const auto reducer = make_chain(std::make_index_sequence<Depth>{})(sum_reducer);
+    run(state, [&](const std::vector<int>& in) { return dux::reduce(std::int64_t{ 0 }, reducer)(in); });
+}
+
+// Same chain over a mutable input, which takes the same path and must run as fast as over the const one.
+template <std::size_t Depth>
+void compose_mutable_dux(benchmark::State& state)
+{
+    const auto reducer = make_chain(std::make_index_sequence<Depth>{})(sum_reducer);
+    std::vector<int> in = make_input(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dux::reduce(std::int64_t{ 0 }, reducer)(in));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <std::size_t Depth>
+void compose_hand_written_loop(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            std::int64_t total = 0;
+            for (int x : in)
+            {
+                for (std::size_t i = 0; i < Depth; ++i)
+                {
+                    x = add_one(x);
+                }
+                total += x;
+            }
+            return total;
+        });
+}
+
+void fork_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            return dux::reduce(
+                std::int64_t{ 0 },
+                dux::fork(
+                    dux::filter(is_even) | sum_reducer,  //
+                    dux::transform(add_one) | sum_reducer,
+                    dux::stride(4) | sum_reducer))(in);
+        });
+}
+
+void tee_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            const auto [count, sum, min, max] = dux::reduce(
+                std::tuple{ std::int64_t{ 0 }, std::int64_t{ 0 }, std::numeric_limits<int>::max(), 0 },
+                dux::tee(
+                    [](std::int64_t total, int) { return total + 1; },  //
+                    sum_reducer,
+                    dux::minimum,
+                    dux::maximum))(in);
+            return count + sum + min + max;
+        });
+}
+
+void parallel_fork_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            const auto [count, sum, min, max] = dux::reduce(
+                std::tuple{ std::int64_t{ 0 }, std::int64_t{ 0 }, std::numeric_limits<int>::max(), 0 },
+                dux::parallel_fork<int>(
+                    [](std::int64_t total, int) { return total + 1; },  //
+                    sum_reducer,
+                    dux::minimum,
+                    dux::maximum))(in);
+            return count + sum + min + max;
+        });
+}
+
+// Two CPU-heavy stages, run on one thread and split across two threads
+
+constexpr inline auto heavy = [](int x)
+{
+    std::uint32_t h = static_cast<std::uint32_t>(x);
+    for (int i = 0; i < 64; ++i)
+    {
+        h = h * 2654435761u + 0x9e3779b9u;
+    }
+    return static_cast<int>(h >> 1);
+};
+
+template <bool Async>
+void two_stage_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            const auto downstream = dux::transform(heavy) | dux::filter(is_even) | sum_reducer;
+            if constexpr (Async)
+            {
+                return dux::reduce(
+                    std::int64_t{ 0 }, dux::transform(heavy) | dux::async_stage<int>() | downstream)(in);
+            }
+            else
+            {
+                return dux::reduce(std::int64_t{ 0 }, dux::transform(heavy) | downstream)(in);
+            }
+        });
+}
+
+// Multiple inputs
+
+template <std::size_t Count>
+void multi_range_dux(benchmark::State& state)
+{
+    const std::vector<int> in = make_input(state.range(0));
+    const auto sum_all = [](std::int64_t total, const auto&... items) { return (total + ... + items); };
+    for (auto _ : state)
+    {
+        if constexpr (Count == 2)
+        {
+            benchmark::DoNotOptimize(dux::reduce(std::int64_t{ 0 }, sum_all)(in, in));
+        }
+        else if constexpr (Count == 3)
+        {
+            benchmark::DoNotOptimize(dux::reduce(std::int64_t{ 0 }, sum_all)(in, in, in));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(dux::reduce(std::int64_t{ 0 }, sum_all)(in, in, in, in));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void multi_range_hand_written_loop(benchmark::State& state)
+{
+    const std::vector<int> in = make_input(state.range(0));
+    for (auto _ : state)
+    {
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i < in.size(); ++i)
+        {
+            total += in[i] + in[i] + in[i];
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#if defined(__cpp_lib_ranges)
+
+void filter_transform_ranges(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            std::int64_t total = 0;
+            for (int x : in | std::views::filter(is_even) | std::views::transform(add_one) | std::views::take(in.size() / 2))
+            {
+                total += x;
+            }
+            return total;
+        });
+}
+
+BENCHMARK(filter_transform_ranges)->Range(1 << 10, 1 << 20);
+
+#endif
+
+void filter_transform_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            return dux::reduce(
+                std::int64_t{ 0 },
+                dux::filter(is_even) | dux::transform(add_one) | dux::take(in.size() / 2) | sum_reducer)(in);
+        });
+}
+
+void filter_transform_any_dux(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            const dux::any_transducer<int, int> xform
+                = dux::filter(is_even) | dux::transform(add_one) | dux::take(in.size() / 2);
+            return dux::reduce(std::int64_t{ 0 }, xform | dux::any_reducer<std::int64_t, int>{ sum_reducer })(in);
+        });
+}
+
+void filter_transform_hand_written_loop(benchmark::State& state)
+{
+    run(state,
+        [](const std::vector<int>& in)
+        {
+            std::int64_t total = 0;
+            std::size_t taken = 0;
+            for (int x : in)
+            {
+                if (!is_even(x))
+                {
+                    continue;
+                }
+                if (taken++ == in.size() / 2)
+                {
+                    break;
+                }
+                total += add_one(x);
+            }
+            return total;
+        });
+}
+
+BENCHMARK(reduce_hand_written_loop)->Range(1 << 10, 1 << 20);
+BENCHMARK(reduce_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(reduce_dux_simd)->Range(1 << 10, 1 << 20);
+BENCHMARK(reduce_double_hand_written_loop)->Range(1 << 10, 1 << 20);
+BENCHMARK(reduce_double_dux_simd)->Range(1 << 10, 1 << 20);
+BENCHMARK(parallel_reduce_dux)->Range(1 << 10, 1 << 24)->UseRealTime();
+
+BENCHMARK(transform_hand_written_loop)->Range(1 << 10, 1 << 20);
+BENCHMARK(transform_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(transform_i_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(transform_maybe_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(filter_hand_written_loop)->Range(1 << 10, 1 << 20);
+BENCHMARK(filter_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(filter_i_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(inspect_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(inspect_i_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(take_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(drop_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(take_while_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(drop_while_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(stride_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(intersperse_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(chunk_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(chunk_arena_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(group_by_unordered_map)->Range(1 << 10, 1 << 20);
+BENCHMARK(group_by_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(distinct_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(distinct_bloom_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(top_k_partial_sort)->Range(1 << 10, 1 << 20);
+BENCHMARK(top_k_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(sort_std)->Range(1 << 10, 1 << 22);
+BENCHMARK(sort_dux)->Range(1 << 10, 1 << 22);
+BENCHMARK(sort_spill_dux)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(window_max_rereduce, 4)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(window_max_rereduce, 64)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(window_max_rereduce, 1024)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(window_max_dux, 4)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(window_max_dux, 64)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(window_max_dux, 1024)->Arg(1 << 16);
+BENCHMARK(join_hand_written_loop)->Range(1 << 10, 1 << 16);
+BENCHMARK(join_dux)->Range(1 << 10, 1 << 16);
+BENCHMARK(join_with_dux)->Range(1 << 10, 1 << 16);
+
+BENCHMARK_TEMPLATE(compose_hand_written_loop, 1)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_dux, 1)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_mutable_dux, 1)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_hand_written_loop, 2)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_dux, 2)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_mutable_dux, 2)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_hand_written_loop, 4)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_dux, 4)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_mutable_dux, 4)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_hand_written_loop, 8)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_dux, 8)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_mutable_dux, 8)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_hand_written_loop, 16)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_dux, 16)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(compose_mutable_dux, 16)->Arg(1 << 16);
+
+BENCHMARK(fork_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(tee_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(parallel_fork_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(two_stage_dux, false)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(two_stage_dux, true)->Range(1 << 10, 1 << 20);
+BENCHMARK(multi_range_hand_written_loop)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(multi_range_dux, 2)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(multi_range_dux, 3)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(multi_range_dux, 4)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(filter_transform_hand_written_loop)->Range(1 << 10, 1 << 20);
+BENCHMARK(filter_transform_dux)->Range(1 << 10, 1 << 20);
+BENCHMARK(filter_transform_any_dux)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
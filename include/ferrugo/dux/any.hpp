@@ -0,0 +1,439 @@
+#pragma once
+
+#include <cstddef>
+#include <ferrugo/dux/interfaces.hpp>
+#include <ferrugo/dux/span.hpp>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+// Owns an object derived from `Base`, kept in an inline buffer of `Size` bytes when it fits there and on the heap
+// otherwise. `Base` must expose `Base* move_to(void*) noexcept`, and `Base* clone(small_box_t&) const` if the box
+// is to be copied.
+template <class Base, std::size_t Size>
+class small_box_t
+{
+public:
+    template <class Impl>
+    static constexpr bool fits_inline = sizeof(Impl) <= Size && alignof(Impl) <= alignof(std::max_align_t)
+                                        && std::is_nothrow_move_constructible_v<Impl>;
+
+    small_box_t() = default;
+
+    small_box_t(const small_box_t& other)
+    {
+        if (other.m_ptr)
+        {
+            other.m_ptr->clone(*this);
+        }
+    }
+
+    small_box_t(small_box_t&& other) noexcept
+    {
+        take(other);
+    }
+
+    small_box_t& operator=(small_box_t other) noexcept
+    {
+        reset();
+        take(other);
+        return *this;
+    }
+
+    ~small_box_t()
+    {
+        reset();
+    }
+
+    template <class Impl, class... Args>
+    void emplace(Args&&... args)
+    {
+        reset();
+        if constexpr (fits_inline<Impl>)
+        {
+            m_ptr = ::new (static_cast<void*>(m_buffer)) Impl(std::forward<Args>(args)...);
+            m_inline = true;
+        }
+        else
+        {
+            m_ptr = new Impl(std::forward<Args>(args)...);
+            m_inline = false;
+        }
+    }
+
+    auto operator->() const -> Base*
+    {
+        return m_ptr;
+    }
+
+    auto get() const -> Base*
+    {
+        return m_ptr;
+    }
+
+private:
+    void reset()
+    {
+        if (m_inline)
+        {
+            m_ptr->~Base();
+        }
+        else
+        {
+            delete m_ptr;
+        }
+        m_ptr = nullptr;
+        m_inline = false;
+    }
+
+    void take(small_box_t& other) noexcept
+    {
+        if (other.m_inline)
+        {
+            m_ptr = other.m_ptr->move_to(m_buffer);
+            m_inline = true;
+            other.reset();
+        }
+        else
+        {
+            m_ptr = std::exchange(other.m_ptr, nullptr);
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char m_buffer[Size];
+    Base* m_ptr = nullptr;
+    bool m_inline = false;
+};
+
+static constexpr inline std::size_t any_reducer_buffer_size = 64;
+static constexpr inline std::size_t any_run_buffer_size = 128;
+
+// Downstream end of an erased chain as seen by the stages before it, which do not know its state type.
+template <class T>
+struct sink_base_t
+{
+    virtual ~sink_base_t() = default;
+    virtual void sink_step(void* state, const T& item) = 0;
+    virtual void sink_step_batch(void* state, span_t<const T> items) = 0;
+    virtual void sink_complete(void* state) = 0;
+    virtual bool done() const = 0;
+};
+
+template <class State, class T>
+struct any_run_base_t : sink_base_t<T>
+{
+    virtual void step(State& state, const T& item) = 0;
+    virtual void step_batch(State& state, span_t<const T> items) = 0;
+    virtual void complete(State& state) = 0;
+    virtual auto move_to(void* buffer) noexcept -> any_run_base_t* = 0;
+
+    void sink_step(void* state, const T& item) final
+    {
+        step(*static_cast<State*>(state), item);
+    }
+
+    void sink_step_batch(void* state, span_t<const T> items) final
+    {
+        step_batch(*static_cast<State*>(state), items);
+    }
+
+    void sink_complete(void* state) final
+    {
+        complete(*static_cast<State*>(state));
+    }
+};
+
+template <class State, class T, class Run>
+struct any_run_impl_t final : any_run_base_t<State, T>
+{
+    Run m_run;
+
+    explicit any_run_impl_t(Run run) : m_run{ std::move(run) }
+    {
+    }
+
+    void step(State& state, const T& item) override
+    {
+        detail::step(m_run, state, item);
+    }
+
+    // The whole batch is handled behind a single virtual call.
+    void step_batch(State& state, span_t<const T> items) override
+    {
+        detail::step_batch(m_run, state, items);
+    }
+
+    bool done() const override
+    {
+        return is_done(m_run);
+    }
+
+    void complete(State& state) override
+    {
+        detail::complete(m_run, state);
+    }
+
+    auto move_to(void* buffer) noexcept -> any_run_base_t<State, T>* override
+    {
+        return ::new (buffer) any_run_impl_t(std::move(*this));
+    }
+};
+
+template <class State, class T>
+using run_box_t = small_box_t<any_run_base_t<State, T>, any_run_buffer_size>;
+
+template <class State, class T>
+struct any_reducer_base_t
+{
+    using box_type = small_box_t<any_reducer_base_t, any_reducer_buffer_size>;
+
+    virtual ~any_reducer_base_t() = default;
+    virtual void start(run_box_t<State, T>& run, const run_context& context) const = 0;
+    virtual void clone(box_type& box) const = 0;
+    virtual auto move_to(void* buffer) noexcept -> any_reducer_base_t* = 0;
+};
+
+template <class State, class T, class Reducer>
+struct any_reducer_impl_t final : any_reducer_base_t<State, T>
+{
+    using box_type = typename any_reducer_base_t<State, T>::box_type;
+
+    Reducer m_reducer;
+
+    explicit any_reducer_impl_t(Reducer reducer) : m_reducer{ std::move(reducer) }
+    {
+    }
+
+    void start(run_box_t<State, T>& run, const run_context& context) const override
+    {
+        run.template emplace<any_run_impl_t<State, T, start_result_t<Reducer>>>(detail::start(m_reducer, context));
+    }
+
+    void clone(box_type& box) const override
+    {
+        box.template emplace<any_reducer_impl_t>(m_reducer);
+    }
+
+    auto move_to(void* buffer) noexcept -> any_reducer_base_t<State, T>* override
+    {
+        return ::new (buffer) any_reducer_impl_t(std::move(*this));
+    }
+};
+
+}  // namespace detail
+
+// Run of an `any_reducer`: one virtual call per item, or per batch through `step_batch`.
+template <class State, class T>
+class any_run
+{
+public:
+    explicit any_run(detail::run_box_t<State, T> box) : m_box{ std::move(box) }
+    {
+    }
+
+    void operator()(State& state, const T& item)
+    {
+        m_box->step(state, item);
+    }
+
+    void step_batch(State& state, span_t<const T> items)
+    {
+        m_box->step_batch(state, items);
+    }
+
+    bool done() const
+    {
+        return m_box->done();
+    }
+
+    void complete(State& state)
+    {
+        m_box->complete(state);
+    }
+
+    auto sink() const -> detail::sink_base_t<T>*
+    {
+        return m_box.get();
+    }
+
+private:
+    detail::run_box_t<State, T> m_box;
+};
+
+// Reducer of items of type `T` into a `State`, with the concrete reducer type erased so that reducers chosen at
+// run time can be stored and passed around. Small reducers are kept inline, without a heap allocation. Whether the
+// erased runs keep state is not known, so it has no call operator: items go through a run from `start()`, as `reduce`
+// does.
+template <class State, class T>
+class any_reducer
+{
+public:
+    template <class Reducer, std::enable_if_t<!std::is_same_v<std::decay_t<Reducer>, any_reducer>, int> = 0>
+    any_reducer(Reducer&& reducer)
+    {
+        m_box.template emplace<detail::any_reducer_impl_t<State, T, std::decay_t<Reducer>>>(
+            std::forward<Reducer>(reducer));
+    }
+
+    auto start(const run_context& context = {}) const -> any_run<State, T>
+    {
+        detail::run_box_t<State, T> run;
+        m_box->start(run, context);
+        return any_run<State, T>{ std::move(run) };
+    }
+
+private:
+    typename detail::any_reducer_base_t<State, T>::box_type m_box;
+};
+
+namespace detail
+{
+
+// State seen by the stages of an erased transducer: the actual state and the downstream run, both erased.
+template <class U>
+struct erased_ref_t
+{
+    void* m_state;
+    sink_base_t<U>* m_sink;
+};
+
+// Last stage of an erased transducer, handing its output over to whichever reducer it is later composed with.
+template <class U>
+struct sink_reducer_t
+{
+    struct run_t
+    {
+        sink_base_t<U>* m_sink = nullptr;
+
+        template <class Arg>
+        void operator()(erased_ref_t<U>& ref, Arg&& arg)
+        {
+            m_sink = ref.m_sink;
+            ref.m_sink->sink_step(ref.m_state, std::forward<Arg>(arg));
+        }
+
+        void step_batch(erased_ref_t<U>& ref, span_t<const U> items)
+        {
+            m_sink = ref.m_sink;
+            ref.m_sink->sink_step_batch(ref.m_state, items);
+        }
+
+        bool done() const
+        {
+            return m_sink && m_sink->done();
+        }
+
+        void complete(erased_ref_t<U>& ref)
+        {
+            ref.m_sink->sink_complete(ref.m_state);
+        }
+    };
+
+    auto start() const -> run_t
+    {
+        return {};
+    }
+};
+
+template <class State, class T, class U>
+struct erased_compose_t
+{
+    any_reducer<erased_ref_t<U>, T> m_upstream;
+    any_reducer<State, U> m_downstream;
+
+    struct run_t
+    {
+        any_run<erased_ref_t<U>, T> m_upstream;
+        any_run<State, U> m_downstream;
+
+        void operator()(State& state, const T& item)
+        {
+            erased_ref_t<U> ref{ &state, m_downstream.sink() };
+            m_upstream(ref, item);
+        }
+
+        void step_batch(State& state, span_t<const T> items)
+        {
+            erased_ref_t<U> ref{ &state, m_downstream.sink() };
+            m_upstream.step_batch(ref, items);
+        }
+
+        bool done() const
+        {
+            return m_upstream.done();
+        }
+
+        void complete(State& state)
+        {
+            erased_ref_t<U> ref{ &state, m_downstream.sink() };
+            m_upstream.complete(ref);
+        }
+    };
+
+    auto start(const run_context& context = {}) const -> run_t
+    {
+        return { m_upstream.start(context), m_downstream.start(context) };
+    }
+};
+
+}  // namespace detail
+
+// Transducer turning items of type `T` into items of type `U`, with the concrete transducer type erased. It composes
+// with an `any_reducer<State, U>` into an `any_reducer<State, T>` and with an `any_transducer<U, V>` into an
+// `any_transducer<T, V>`. The wrapped stages are instantiated once, for an erased state, and cross over to the
+// rest of the chain through one virtual call per item they emit, or per batch for the stages that emit batches.
+template <class T, class U>
+class any_transducer
+{
+public:
+    template <class Transducer, std::enable_if_t<!std::is_same_v<std::decay_t<Transducer>, any_transducer>, int> = 0>
+    any_transducer(Transducer&& transducer)
+        : m_reducer{ std::invoke(std::forward<Transducer>(transducer), detail::sink_reducer_t<U>{}) }
+    {
+    }
+
+    template <class State>
+    auto operator()(any_reducer<State, U> next) const -> any_reducer<State, T>
+    {
+        return detail::erased_compose_t<State, T, U>{ m_reducer, std::move(next) };
+    }
+
+    template <class State>
+    auto operator|(any_reducer<State, U> next) const -> any_reducer<State, T>
+    {
+        return (*this)(std::move(next));
+    }
+
+    template <class V>
+    auto operator|(const any_transducer<U, V>& next) const -> any_transducer<T, V>
+    {
+        using compose_type = detail::erased_compose_t<detail::erased_ref_t<V>, T, U>;
+        using tag_type = typename any_transducer<T, V>::from_reducer_tag;
+        return any_transducer<T, V>{ tag_type{}, compose_type{ m_reducer, next.m_reducer } };
+    }
+
+private:
+    template <class, class>
+    friend class any_transducer;
+
+    struct from_reducer_tag
+    {
+    };
+
+    any_transducer(from_reducer_tag, any_reducer<detail::erased_ref_t<U>, T> reducer) : m_reducer{ std::move(reducer) }
+    {
+    }
+
+    any_reducer<detail::erased_ref_t<U>, T> m_reducer;
+};
+
+}  // namespace dux
+}  // namespace ferrugo
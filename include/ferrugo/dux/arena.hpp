@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <ferrugo/dux/interfaces.hpp>
+#include <memory_resource>
+#include <mutex>
+#include <utility>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+// Monotonic memory for the buffers of the runs of a reduction. Allocations are carved out of blocks which grow
+// geometrically and are given back all at once by `release()`; `reduce` releases the arena after every reduction
+// it was given to, so that repeated reductions keep reusing the same blocks. Allocations are serialized, since stages
+// such as `async_stage` or `parallel_fork` allocate from it on their worker threads too.
+class arena
+{
+public:
+    arena() = default;
+
+    explicit arena(std::size_t initial_size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : m_resource{ initial_size, upstream }
+    {
+    }
+
+    // Starts from a caller provided buffer, e.g. one on the stack; `upstream` is used only once it is exhausted.
+    arena(void* buffer, std::size_t size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : m_resource{ buffer, size, upstream }
+    {
+    }
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    auto resource() -> std::pmr::memory_resource*
+    {
+        return &m_resource;
+    }
+
+    auto context() -> run_context
+    {
+        return run_context{ &m_resource };
+    }
+
+    void release()
+    {
+        m_resource.release();
+    }
+
+private:
+    class resource_t : public std::pmr::memory_resource
+    {
+    public:
+        template <class... Args>
+        explicit resource_t(Args&&... args) : m_resource{ std::forward<Args>(args)... }
+        {
+        }
+
+        void release()
+        {
+            const std::lock_guard<std::mutex> lock{ m_mutex };
+            m_resource.release();
+        }
+
+    private:
+        auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+        {
+            const std::lock_guard<std::mutex> lock{ m_mutex };
+            return m_resource.allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+        {
+            const std::lock_guard<std::mutex> lock{ m_mutex };
+            m_resource.deallocate(pointer, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        std::mutex m_mutex;
+        std::pmr::monotonic_buffer_resource m_resource;
+    };
+
+    resource_t m_resource;
+};
+
+}  // namespace dux
+}  // namespace ferrugo
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <vector>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+struct bloom_options
+{
+    std::size_t expected_count = std::size_t{ 1 } << 20;
+    double false_positive_rate = 0.01;
+};
+
+namespace detail
+{
+
+// Finalizer of splitmix64, turning any hash into one whose bits all depend on every input bit.
+constexpr auto mix64(std::uint64_t x) -> std::uint64_t
+{
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+}  // namespace detail
+
+// Probabilistic set of keys in a fixed amount of memory: `insert` tells for certain when a key is new, and mistakes a
+// new key for one already seen with about the configured rate once `expected_count` keys are in. The filter is blocked:
+// all the bits of a key lie within one cache line, so that each call touches memory once.
+template <class Key, class Hash = std::hash<Key>>
+class bloom_filter
+{
+public:
+    static constexpr inline std::size_t block_words = 8;
+    static constexpr inline std::size_t block_bits = block_words * 64;
+
+    explicit bloom_filter(
+        bloom_options options = {}, Hash hash = {}, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_hash{ std::move(hash) }
+        , m_words{ resource }
+    {
+        const double ln2 = std::log(2.0);
+        const double count = static_cast<double>(std::max(options.expected_count, std::size_t{ 1 }));
+        const double rate = std::clamp(options.false_positive_rate, 1e-9, 0.5);
+        const double bits = -count * std::log(rate) / (ln2 * ln2);
+        std::size_t block_count = 1;
+        while (static_cast<double>(block_count * block_bits) < bits)
+        {
+            block_count *= 2;
+        }
+        m_block_mask = block_count - 1;
+        m_hash_count = static_cast<unsigned>(std::clamp(std::lround(-std::log2(rate)), 1L, 16L));
+        m_words.assign(block_count * block_words, 0);
+    }
+
+    // Adds `key`, returning false when it may have been added before and true when it certainly was not.
+    bool insert(const Key& key)
+    {
+        bool added = false;
+        visit(*this, key, [&](std::uint64_t& word, std::uint64_t bit) { added |= (word & bit) == 0; word |= bit; });
+        return added;
+    }
+
+    bool contains(const Key& key) const
+    {
+        bool found = true;
+        visit(*this, key, [&](const std::uint64_t& word, std::uint64_t bit) { found &= (word & bit) != 0; });
+        return found;
+    }
+
+private:
+    // Calls `func(word, bit)` for each of the bits of `key`, derived from two hashes as `h1 + i * h2`.
+    template <class Self, class Func>
+    static void visit(Self& self, const Key& key, Func func)
+    {
+        const std::uint64_t h = detail::mix64(static_cast<std::uint64_t>(std::invoke(self.m_hash, key)));
+        auto* block = self.m_words.data() + static_cast<std::size_t>((h >> 32) & self.m_block_mask) * block_words;
+        std::uint64_t h1 = h;
+        const std::uint64_t h2 = detail::mix64(h) | 1;
+        for (unsigned i = 0; i < self.m_hash_count; ++i, h1 += h2)
+        {
+            const std::size_t index = static_cast<std::size_t>(h1 % block_bits);
+            func(block[index / 64], std::uint64_t{ 1 } << (index % 64));
+        }
+    }
+
+    Hash m_hash;
+    std::pmr::vector<std::uint64_t> m_words;
+    std::size_t m_block_mask = 0;
+    unsigned m_hash_count = 1;
+};
+
+}  // namespace dux
+}  // namespace ferrugo
@@ -1,17 +1,38 @@
 #pragma once
 
+#include <ferrugo/dux/any.hpp>
+#include <ferrugo/dux/arena.hpp>
+#include <ferrugo/dux/bloom_filter.hpp>
 #include <ferrugo/dux/compose.hpp>
+#include <ferrugo/dux/flat_table.hpp>
+#include <ferrugo/dux/parallel_reduce.hpp>
 #include <ferrugo/dux/reduce.hpp>
 #include <ferrugo/dux/reducers/dev_null.hpp>
+#include <ferrugo/dux/reducers/emplace_back.hpp>
 #include <ferrugo/dux/reducers/fork.hpp>
+#include <ferrugo/dux/reducers/group_by.hpp>
+#include <ferrugo/dux/reducers/minmax.hpp>
+#include <ferrugo/dux/reducers/parallel_fork.hpp>
+#include <ferrugo/dux/reducers/top_k.hpp>
+#include <ferrugo/dux/reducers/write.hpp>
+#include <ferrugo/dux/sources/columns.hpp>
+#include <ferrugo/dux/sources/lines.hpp>
+#include <ferrugo/dux/sources/mapped_file.hpp>
+#include <ferrugo/dux/sources/read.hpp>
+#include <ferrugo/dux/transducers/async_stage.hpp>
+#include <ferrugo/dux/transducers/chunk.hpp>
+#include <ferrugo/dux/transducers/distinct.hpp>
 #include <ferrugo/dux/transducers/drop.hpp>
 #include <ferrugo/dux/transducers/drop_while.hpp>
 #include <ferrugo/dux/transducers/filter.hpp>
 #include <ferrugo/dux/transducers/inspect.hpp>
 #include <ferrugo/dux/transducers/intersperse.hpp>
 #include <ferrugo/dux/transducers/join.hpp>
+#include <ferrugo/dux/transducers/par_transform.hpp>
+#include <ferrugo/dux/transducers/sort.hpp>
 #include <ferrugo/dux/transducers/stride.hpp>
 #include <ferrugo/dux/transducers/take.hpp>
 #include <ferrugo/dux/transducers/take_while.hpp>
 #include <ferrugo/dux/transducers/transform.hpp>
 #include <ferrugo/dux/transducers/transform_maybe.hpp>
+#include <ferrugo/dux/transducers/window.hpp>
@@ -0,0 +1,389 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+namespace detail
+{
+
+// Insert-only hash table with open addressing: entries live in one contiguous array of slots, a lookup probes the
+// slots following the home slot of the key until it meets the key or an empty slot. The table grows by doubling
+// once three quarters of the slots are taken. The home slot is picked by the high bits of the hash multiplied by the
+// golden ratio (Fibonacci hashing), which spreads both runs of nearby keys and keys sharing their low bits even though
+// std::hash of integers is the identity. `KeyOf` extracts the key of an entry.
+template <class Entry, class KeyOf, class Hash, class KeyEqual>
+class flat_table_t
+{
+    using slot_type = std::optional<Entry>;
+
+    template <bool Const>
+    class iterator_t
+    {
+    public:
+        using slot_pointer = std::conditional_t<Const, const slot_type*, slot_type*>;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const Entry&, Entry&>;
+        using pointer = std::conditional_t<Const, const Entry*, Entry*>;
+
+        iterator_t() = default;
+
+        iterator_t(slot_pointer slot, slot_pointer end) : m_slot{ slot }, m_end{ end }
+        {
+            skip_empty();
+        }
+
+        template <bool C = Const, std::enable_if_t<C, int> = 0>
+        iterator_t(const iterator_t<false>& other) : m_slot{ other.m_slot }, m_end{ other.m_end }
+        {
+        }
+
+        auto operator*() const -> reference
+        {
+            return **m_slot;
+        }
+
+        auto operator->() const -> pointer
+        {
+            return &**m_slot;
+        }
+
+        auto operator++() -> iterator_t&
+        {
+            ++m_slot;
+            skip_empty();
+            return *this;
+        }
+
+        auto operator++(int) -> iterator_t
+        {
+            iterator_t result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==(const iterator_t& lhs, const iterator_t& rhs)
+        {
+            return lhs.m_slot == rhs.m_slot;
+        }
+
+        friend bool operator!=(const iterator_t& lhs, const iterator_t& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class flat_table_t;
+        friend class iterator_t<true>;
+
+        void skip_empty()
+        {
+            while (m_slot != m_end && !*m_slot)
+            {
+                ++m_slot;
+            }
+        }
+
+        slot_pointer m_slot = nullptr;
+        slot_pointer m_end = nullptr;
+    };
+
+public:
+    using value_type = Entry;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using iterator = iterator_t<false>;
+    using const_iterator = iterator_t<true>;
+
+    flat_table_t() = default;
+
+    explicit flat_table_t(std::size_t count, Hash hash = {}, KeyEqual equal = {})
+        : m_hash{ std::move(hash) }
+        , m_equal{ std::move(equal) }
+    {
+        reserve(count);
+    }
+
+    // Takes the slots from `resource`, e.g. the one of a run context.
+    flat_table_t(std::size_t count, std::pmr::memory_resource* resource) : m_slots{ resource }
+    {
+        reserve(count);
+    }
+
+    auto size() const -> std::size_t
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    // Number of entries the table holds before it has to grow.
+    auto capacity() const -> std::size_t
+    {
+        return m_slots.size() / 4 * 3;
+    }
+
+    void reserve(std::size_t count)
+    {
+        if (count > capacity())
+        {
+            std::size_t slot_count = 16;
+            while (slot_count / 4 * 3 < count)
+            {
+                slot_count *= 2;
+            }
+            rehash(slot_count);
+        }
+    }
+
+    void clear()
+    {
+        for (slot_type& slot : m_slots)
+        {
+            slot.reset();
+        }
+        m_size = 0;
+    }
+
+    auto begin() -> iterator
+    {
+        return iterator{ m_slots.data(), m_slots.data() + m_slots.size() };
+    }
+
+    auto end() -> iterator
+    {
+        return iterator{ m_slots.data() + m_slots.size(), m_slots.data() + m_slots.size() };
+    }
+
+    auto begin() const -> const_iterator
+    {
+        return const_iterator{ m_slots.data(), m_slots.data() + m_slots.size() };
+    }
+
+    auto end() const -> const_iterator
+    {
+        return const_iterator{ m_slots.data() + m_slots.size(), m_slots.data() + m_slots.size() };
+    }
+
+    template <class Key>
+    auto find(const Key& key) -> iterator
+    {
+        return iterator{ m_slots.data() + find_index(key), m_slots.data() + m_slots.size() };
+    }
+
+    template <class Key>
+    auto find(const Key& key) const -> const_iterator
+    {
+        return const_iterator{ m_slots.data() + find_index(key), m_slots.data() + m_slots.size() };
+    }
+
+    template <class Key>
+    bool contains(const Key& key) const
+    {
+        return find_index(key) != m_slots.size();
+    }
+
+protected:
+    // Looks `key` up and, when it is missing, inserts the entry returned by `make()`. The table only grows for an
+    // insertion, so finding the key leaves iterators and references valid.
+    template <class Key, class Make>
+    auto insert_with(const Key& key, Make&& make) -> std::pair<iterator, bool>
+    {
+        std::size_t index = m_slots.empty() ? 0 : probe(key);
+        if (!m_slots.empty() && m_slots[index])
+        {
+            return { iterator{ &m_slots[index], m_slots.data() + m_slots.size() }, false };
+        }
+        if (m_size + 1 > capacity())
+        {
+            reserve(m_size + 1);
+            index = probe(key);
+        }
+        m_slots[index].emplace(std::invoke(std::forward<Make>(make)));
+        ++m_size;
+        return { iterator{ &m_slots[index], m_slots.data() + m_slots.size() }, true };
+    }
+
+private:
+    template <class Key>
+    auto slot_index(const Key& key) const -> std::size_t
+    {
+        const auto hash = static_cast<std::uint64_t>(std::invoke(m_hash, key));
+        return static_cast<std::size_t>((hash * 0x9E3779B97F4A7C15ull) >> m_shift);
+    }
+
+    // Index of the first slot from the home slot of `key` on which either holds `key` or is empty.
+    template <class Key>
+    auto probe(const Key& key) const -> std::size_t
+    {
+        const std::size_t mask = m_slots.size() - 1;
+        std::size_t index = slot_index(key);
+        while (m_slots[index] && !std::invoke(m_equal, KeyOf{}(*m_slots[index]), key))
+        {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    // Index of the slot holding `key`, or the number of slots if there is none.
+    template <class Key>
+    auto find_index(const Key& key) const -> std::size_t
+    {
+        if (m_size == 0)
+        {
+            return m_slots.size();
+        }
+        const std::size_t index = probe(key);
+        return m_slots[index] ? index : m_slots.size();
+    }
+
+    void rehash(std::size_t slot_count)
+    {
+        std::pmr::vector<slot_type> slots(slot_count, m_slots.get_allocator());
+        std::swap(m_slots, slots);
+        m_shift = 64;
+        for (std::size_t count = slot_count; count > 1; count /= 2)
+        {
+            --m_shift;
+        }
+        const std::size_t mask = slot_count - 1;
+        for (slot_type& slot : slots)
+        {
+            if (slot)
+            {
+                std::size_t index = slot_index(KeyOf{}(*slot));
+                while (m_slots[index])
+                {
+                    index = (index + 1) & mask;
+                }
+                m_slots[index].emplace(std::move(*slot));
+            }
+        }
+    }
+
+    std::pmr::vector<slot_type> m_slots = {};
+    std::size_t m_size = 0;
+    unsigned m_shift = 64;
+    Hash m_hash = {};
+    KeyEqual m_equal = {};
+};
+
+struct self_fn
+{
+    template <class Key>
+    constexpr auto operator()(const Key& key) const -> const Key&
+    {
+        return key;
+    }
+};
+
+struct first_fn
+{
+    template <class Pair>
+    constexpr auto operator()(const Pair& pair) const -> const typename Pair::first_type&
+    {
+        return pair.first;
+    }
+};
+
+}  // namespace detail
+
+// Hash map on a flat open addressing table, for building up per key results: entries are only ever added, and stay
+// in one contiguous array instead of separately allocated nodes. Entries are `std::pair<Key, Value>` whose key
+// must not be modified through iterators. Iterators and references are invalidated when the map grows; `reserve`
+// sizes it upfront.
+template <class Key, class Value, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class flat_map : public detail::flat_table_t<std::pair<Key, Value>, detail::first_fn, Hash, KeyEqual>
+{
+    using base_type = detail::flat_table_t<std::pair<Key, Value>, detail::first_fn, Hash, KeyEqual>;
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using typename base_type::iterator;
+
+    using base_type::base_type;
+
+    template <class... Args>
+    auto try_emplace(const Key& key, Args&&... args) -> std::pair<iterator, bool>
+    {
+        return emplace_key(key, std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    auto try_emplace(Key&& key, Args&&... args) -> std::pair<iterator, bool>
+    {
+        return emplace_key(std::move(key), std::forward<Args>(args)...);
+    }
+
+    auto operator[](const Key& key) -> Value&
+    {
+        return emplace_key(key).first->second;
+    }
+
+    auto operator[](Key&& key) -> Value&
+    {
+        return emplace_key(std::move(key)).first->second;
+    }
+
+private:
+    // The key and the arguments are only consumed when the entry is actually inserted.
+    template <class K, class... Args>
+    auto emplace_key(K&& key, Args&&... args) -> std::pair<iterator, bool>
+    {
+        return this->insert_with(
+            key,
+            [&]()
+            {
+                return std::pair<Key, Value>(
+                    std::piecewise_construct,
+                    std::forward_as_tuple(std::forward<K>(key)),
+                    std::forward_as_tuple(std::forward<Args>(args)...));
+            });
+    }
+};
+
+// Hash set on the same flat table as `flat_map`, for remembering which keys have been seen. Keys are only ever
+// added; iterators are invalidated when the set grows.
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class flat_set : public detail::flat_table_t<Key, detail::self_fn, Hash, KeyEqual>
+{
+    using base_type = detail::flat_table_t<Key, detail::self_fn, Hash, KeyEqual>;
+
+public:
+    using key_type = Key;
+    using typename base_type::iterator;
+
+    using base_type::base_type;
+
+    auto insert(const Key& key) -> std::pair<iterator, bool>
+    {
+        return this->insert_with(key, [&]() { return key; });
+    }
+
+    auto insert(Key&& key) -> std::pair<iterator, bool>
+    {
+        return this->insert_with(key, [&]() { return std::move(key); });
+    }
+};
+
+}  // namespace dux
+}  // namespace ferrugo
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <utility>
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+struct identity_fn
+{
+    template <class T>
+    constexpr auto operator()(T&& item) const -> T&&
+    {
+        return std::forward<T>(item);
+    }
+};
+
+}  // namespace detail
+}  // namespace dux
+}  // namespace ferrugo
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
+#include <memory_resource>
+#include <optional>
 #include <type_traits>
 
 namespace ferrugo
@@ -8,15 +11,316 @@ namespace ferrugo
 namespace dux
 {
 
+// Carried from a reduction into every run of its chain. Stages that buffer items take their memory from `resource`
+// instead of the global allocator.
+struct run_context
+{
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+};
+
+namespace detail
+{
+
+template <class Reducer, class = void>
+struct has_done : std::false_type
+{
+};
+
+template <class Reducer>
+struct has_done<Reducer, std::void_t<decltype(std::declval<const Reducer&>().done())>> : std::true_type
+{
+};
+
+// A reducer signals that it will not accept any more input by exposing `bool done() const`.
+// Reducers without it (plain callables) are never done.
+static constexpr inline struct is_done_fn
+{
+    template <class Reducer>
+    constexpr bool operator()(const Reducer& reducer) const
+    {
+        if constexpr (has_done<Reducer>::value)
+        {
+            return reducer.done();
+        }
+        else
+        {
+            return false;
+        }
+    }
+} is_done;
+
+// A reducer updates the state in place when it can be called as `void(State&, Args...)`; otherwise it is called in
+// the value form `State(State, Args...)` and its result is assigned back. Transducers and runs use the former so that
+// a heavy accumulator is never moved while it passes through a chain.
+template <class Reducer, class State, class Args, class = void>
+struct is_in_place : std::false_type
+{
+};
+
+template <class Reducer, class State, class... Args>
+struct is_in_place<
+    Reducer,
+    State,
+    void(Args...),
+    std::enable_if_t<std::is_void_v<std::invoke_result_t<Reducer&, State&, Args...>>>> : std::true_type
+{
+};
+
+static constexpr inline struct step_fn
+{
+    template <class Reducer, class State, class... Args>
+    constexpr void operator()(Reducer& reducer, State& state, Args&&... args) const
+    {
+        if constexpr (is_in_place<Reducer, State, void(Args&&...)>::value)
+        {
+            std::invoke(reducer, state, std::forward<Args>(args)...);
+        }
+        else
+        {
+            state = std::invoke(reducer, std::move(state), std::forward<Args>(args)...);
+        }
+    }
+} step;
+
+template <class Reducer, class State, class = void>
+struct has_complete : std::false_type
+{
+};
+
+template <class Reducer, class State>
+struct has_complete<Reducer, State, std::void_t<decltype(std::declval<Reducer&>().complete(std::declval<State&>()))>>
+    : std::true_type
+{
+};
+
+// Completion step, invoked once after the last input so that buffering reducers can flush what they hold.
+// Like the step, it is either `void complete(State&)` or `State complete(State)`.
+static constexpr inline struct complete_fn
+{
+    template <class Reducer, class State>
+    constexpr void operator()(Reducer& reducer, State& state) const
+    {
+        if constexpr (has_complete<Reducer, State>::value)
+        {
+            if constexpr (std::is_void_v<decltype(reducer.complete(state))>)
+            {
+                reducer.complete(state);
+            }
+            else
+            {
+                state = reducer.complete(std::move(state));
+            }
+        }
+    }
+} complete;
+
+// Initial step, yielding the state a reduction starts from when none is given.
+static constexpr inline struct init_fn
+{
+    template <class Reducer>
+    constexpr auto operator()(const Reducer& reducer) const -> decltype(reducer.init())
+    {
+        return reducer.init();
+    }
+} init;
+
+template <class Reducer, class = void>
+struct has_size_hint : std::false_type
+{
+};
+
+template <class Reducer>
+struct has_size_hint<Reducer, std::void_t<decltype(std::declval<const Reducer&>().size_hint(std::size_t{}))>>
+    : std::true_type
+{
+};
+
+// Number of items that reach the end of the chain out of `count` inputs: exact for size preserving stages, an upper
+// bound for the filtering ones, empty when it cannot be told. A reducer without it consumes every input it gets.
+static constexpr inline struct size_hint_fn
+{
+    template <class Reducer>
+    constexpr auto operator()(const Reducer& reducer, std::size_t count) const -> std::optional<std::size_t>
+    {
+        if constexpr (has_size_hint<Reducer>::value)
+        {
+            return reducer.size_hint(count);
+        }
+        else
+        {
+            return count;
+        }
+    }
+} size_hint;
+
+// Run of a reducer which keeps no per-run state of its own, e.g. a plain callable.
+template <class Reducer>
+struct ref_run_t
+{
+    static constexpr bool stateless = true;
+
+    const Reducer* m_reducer;
+
+    template <class State, class... Args>
+    constexpr void operator()(State& state, Args&&... args) const
+    {
+        step(*m_reducer, state, std::forward<Args>(args)...);
+    }
+
+    constexpr bool done() const
+    {
+        return is_done(*m_reducer);
+    }
+
+    template <class State>
+    constexpr void complete(State& state) const
+    {
+        detail::complete(*m_reducer, state);
+    }
+
+    template <class State, class Items, class R = Reducer>
+    constexpr auto step_batch(State& state, const Items& items) const
+        -> decltype(std::declval<const R&>().step_batch(state, items))
+    {
+        return m_reducer->step_batch(state, items);
+    }
+};
+
+template <class Reducer, class = void>
+struct has_start : std::false_type
+{
+};
+
+template <class Reducer>
+struct has_start<Reducer, std::void_t<decltype(std::declval<const Reducer&>().start())>> : std::true_type
+{
+};
+
+template <class Reducer, class = void>
+struct has_start_with_context : std::false_type
+{
+};
+
+template <class Reducer>
+struct has_start_with_context<
+    Reducer,
+    std::void_t<decltype(std::declval<const Reducer&>().start(std::declval<const run_context&>()))>> : std::true_type
+{
+};
+
+// A built reducer is immutable and may be shared between threads; everything that changes while consuming the input
+// (counters, flags, buffers) lives in the run object returned by `start()`, created afresh for every reduction.
+// Stages taking `start(const run_context&)` pass the context on to the rest of the chain.
+static constexpr inline struct start_fn
+{
+    template <class Reducer>
+    constexpr auto operator()(const Reducer& reducer, const run_context& context = {}) const
+    {
+        if constexpr (has_start_with_context<Reducer>::value)
+        {
+            return reducer.start(context);
+        }
+        else if constexpr (has_start<Reducer>::value)
+        {
+            return reducer.start();
+        }
+        else
+        {
+            return ref_run_t<Reducer>{ &reducer };
+        }
+    }
+} start;
+
+// A run may take a whole contiguous batch of items at once through `step_batch(State&, Items)`.
+template <class Run, class State, class Items, class = void>
+struct has_step_batch : std::false_type
+{
+};
+
+template <class Run, class State, class Items>
+struct has_step_batch<
+    Run,
+    State,
+    Items,
+    std::void_t<decltype(std::declval<Run&>().step_batch(std::declval<State&>(), std::declval<Items>()))>>
+    : std::true_type
+{
+};
+
+// Hands a contiguous batch to a run, item by item when the run has no batch step of its own.
+static constexpr inline struct step_batch_fn
+{
+    template <class Run, class State, class Items>
+    constexpr void operator()(Run& run, State& state, const Items& items) const
+    {
+        if constexpr (has_step_batch<Run, State, const Items&>::value)
+        {
+            run.step_batch(state, items);
+        }
+        else
+        {
+            for (auto it = items.begin(); it != items.end() && !is_done(run); ++it)
+            {
+                step(run, state, *it);
+            }
+        }
+    }
+} step_batch;
+
+template <class Reducer>
+using start_result_t = decltype(start(std::declval<const Reducer&>()));
+
+// A run is stateless when it keeps nothing from one item to the next, so that a fresh run per item behaves like a
+// single run over all of them. Runs say so with `static constexpr bool stateless = true`.
+template <class Run, class = void>
+struct is_stateless_run : std::false_type
+{
+};
+
+template <class Run>
+struct is_stateless_run<Run, std::enable_if_t<Run::stateless>> : std::true_type
+{
+};
+
+template <class... Runs>
+static constexpr inline bool all_stateless_runs = (... && is_stateless_run<Runs>::value);
+
+}  // namespace detail
+
 template <class Impl>
 struct reducer_interface_t
 {
     Impl m_impl;
 
-    template <class State, class... Args>
+    // Steps the item through a run of its own. Only chains whose runs are stateless may be called this way, and those
+    // may be called from several threads at once; chains with stateful stages such as `take` or `chunk` go through
+    // `start()` or `reduce`.
+    template <
+        class State,
+        class... Args,
+        class I = Impl,
+        std::enable_if_t<detail::is_stateless_run<detail::start_result_t<I>>::value, int> = 0>
     constexpr auto operator()(State state, Args&&... args) const -> State
     {
-        return std::invoke(m_impl, std::move(state), std::forward<Args>(args)...);
+        auto run = detail::start(m_impl);
+        detail::step(run, state, std::forward<Args>(args)...);
+        return state;
+    }
+
+    constexpr auto start(const run_context& context = {}) const -> detail::start_result_t<Impl>
+    {
+        return detail::start(m_impl, context);
+    }
+
+    template <class I = Impl>
+    constexpr auto init() const -> decltype(detail::init(std::declval<const I&>()))
+    {
+        return detail::init(m_impl);
+    }
+
+    constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+    {
+        return detail::size_hint(m_impl, count);
     }
 };
 
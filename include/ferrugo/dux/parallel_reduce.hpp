@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <ferrugo/dux/reduce.hpp>
+#include <ferrugo/dux/thread_pool.hpp>
+#include <iterator>
+#include <optional>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+namespace detail
+{
+
+template <class Iter>
+struct subrange_t
+{
+    Iter m_begin;
+    Iter m_end;
+
+    auto begin() const -> Iter
+    {
+        return m_begin;
+    }
+
+    auto end() const -> Iter
+    {
+        return m_end;
+    }
+};
+
+// Items [first, last) of a range; a span over contiguous ranges, so that slices still take the SIMD and batch paths.
+template <class Range>
+auto slice_range(Range& range, std::ptrdiff_t first, std::ptrdiff_t last)
+{
+    if constexpr (is_contiguous_range<Range>::value)
+    {
+        return span_t<contiguous_item_t<Range>>{ std::data(range) + first, static_cast<std::size_t>(last - first) };
+    }
+    else
+    {
+        return subrange_t<decltype(std::begin(range))>{ std::next(std::begin(range), first),
+                                                        std::next(std::begin(range), last) };
+    }
+}
+
+template <class Range>
+using iterator_category_t = typename std::iterator_traits<decltype(std::begin(std::declval<Range&>()))>::iterator_category;
+
+struct parallel_reduce_fn
+{
+    static constexpr inline std::ptrdiff_t min_slice_size = 1024;
+
+    template <class State, class Reducer, class Combine>
+    struct proxy_t
+    {
+        thread_pool* m_pool;
+        State m_state;
+        Reducer m_reducer;
+        Combine m_combine;
+
+        template <class... Ranges>
+        auto operator()(Ranges&&... ranges) const -> State
+        {
+            static_assert(
+                (std::is_base_of_v<std::random_access_iterator_tag, iterator_category_t<Ranges>> && ...),
+                "parallel_reduce requires random access ranges");
+
+            const std::ptrdiff_t size = std::min({ std::ptrdiff_t(std::distance(std::begin(ranges), std::end(ranges)))... });
+            const std::ptrdiff_t slice_count = std::max(
+                std::ptrdiff_t{ 1 },
+                std::min(std::ptrdiff_t(4 * m_pool->size()), size / min_slice_size));
+
+            const auto slice = [&](std::ptrdiff_t index) -> State
+            {
+                const std::ptrdiff_t first = size * index / slice_count;
+                const std::ptrdiff_t last = size * (index + 1) / slice_count;
+                return reduce_ranges(run_context{}, m_state, m_reducer, slice_range(ranges, first, last)...);
+            };
+
+            std::vector<std::future<State>> futures;
+            futures.reserve(slice_count - 1);
+            for (std::ptrdiff_t index = 1; index < slice_count; ++index)
+            {
+                futures.push_back(m_pool->submit([&slice, index]() { return slice(index); }));
+            }
+
+            // Every submitted slice references the ranges, so all of them are awaited before an exception escapes.
+            std::exception_ptr error;
+            std::optional<State> result;
+            try
+            {
+                result.emplace(slice(0));
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            for (std::future<State>& future : futures)
+            {
+                try
+                {
+                    State partial = m_pool->wait(future);
+                    if (!error)
+                    {
+                        result = std::invoke(m_combine, *std::move(result), std::move(partial));
+                    }
+                }
+                catch (...)
+                {
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            }
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+            return *std::move(result);
+        }
+
+        template <class Range>
+        friend auto operator|(Range&& range, const proxy_t& proxy) -> State
+        {
+            return proxy(std::forward<Range>(range));
+        }
+
+        template <class... Ranges>
+        friend auto operator|(const std::tuple<Ranges...>& ranges, const proxy_t& proxy) -> State
+        {
+            return std::apply(proxy, ranges);
+        }
+
+        template <class... Ranges>
+        friend auto operator|(std::tuple<Ranges...>&& ranges, const proxy_t& proxy) -> State
+        {
+            return std::apply(proxy, std::move(ranges));
+        }
+    };
+
+    template <class State, class Reducer, class Combine>
+    auto operator()(thread_pool& pool, State state, Reducer&& reducer, Combine&& combine) const
+        -> proxy_t<State, std::decay_t<Reducer>, std::decay_t<Combine>>
+    {
+        return { &pool, std::move(state), std::forward<Reducer>(reducer), std::forward<Combine>(combine) };
+    }
+
+    template <class State, class Reducer, class Combine>
+    auto operator()(State state, Reducer&& reducer, Combine&& combine) const
+        -> proxy_t<State, std::decay_t<Reducer>, std::decay_t<Combine>>
+    {
+        return (*this)(
+            thread_pool::instance(), std::move(state), std::forward<Reducer>(reducer), std::forward<Combine>(combine));
+    }
+};
+
+}  // namespace detail
+
+// Splits random access inputs into slices reduced concurrently on the thread pool, each slice starting from a copy
+// of the initial state and its own run of the reducer; partial states are merged in input order with the associative
+// `combine`. Stages that depend on the position of items, such as `take`, `drop`, `stride` or `chunk`, therefore
+// apply to every slice on its own.
+static constexpr inline auto parallel_reduce = detail::parallel_reduce_fn{};
+
+}  // namespace dux
+}  // namespace ferrugo
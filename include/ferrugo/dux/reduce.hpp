@@ -1,8 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <ferrugo/dux/arena.hpp>
+#include <ferrugo/dux/reducers/emplace_back.hpp>
 #include <ferrugo/dux/reducers/output.hpp>
+#include <ferrugo/dux/simd.hpp>
+#include <ferrugo/dux/span.hpp>
 #include <ferrugo/dux/to_tuple.hpp>
 #include <functional>
+#include <iterator>
 #include <type_traits>
 
 namespace ferrugo
@@ -38,20 +44,100 @@ void inc(Iter& iter)
 static constexpr inline struct invoke_reducer_fn
 {
     template <class Reducer, class State, class Iter>
-    auto operator()(Reducer&& reducer, State state, Iter it) const -> State
+    void operator()(Reducer& reducer, State& state, const Iter& it) const
     {
-        return call(
-            std::forward<Reducer>(reducer), std::move(state), it, std::make_index_sequence<std::tuple_size_v<Iter>>{});
+        call(reducer, state, it, std::make_index_sequence<std::tuple_size_v<Iter>>{});
     }
 
 private:
     template <class Reducer, class State, class Iter, std::size_t... I>
-    static auto call(Reducer&& reducer, State state, Iter it, std::index_sequence<I...>) -> State
+    static void call(Reducer& reducer, State& state, const Iter& it, std::index_sequence<I...>)
     {
-        return std::invoke(std::forward<Reducer>(reducer), std::move(state), *std::get<I>(it)...);
+        step(reducer, state, *std::get<I>(it)...);
     }
 } invoke_reducer;
 
+template <class Range, class = void>
+struct is_random_access_range : std::false_type
+{
+};
+
+template <class Range>
+struct is_random_access_range<
+    Range,
+    std::enable_if_t<std::is_same_v<
+        decltype(std::begin(std::declval<Range&>())),
+        decltype(std::end(std::declval<Range&>()))>>>
+    : std::is_base_of<
+          std::random_access_iterator_tag,
+          typename std::iterator_traits<decltype(std::begin(std::declval<Range&>()))>::iterator_category>
+{
+};
+
+// Item of a contiguous range as the range gives it, const or not.
+template <class Range>
+using contiguous_item_t = std::remove_pointer_t<decltype(std::data(std::declval<Range&>()))>;
+
+template <class State, class Reducer, class Range, class = void>
+struct is_batch_reducible : std::false_type
+{
+};
+
+// A single contiguous range goes to a run with `step_batch` in one call, as a span of items as const as the range's own,
+// so that the stages past a batch get the same item references as when stepped one by one.
+template <class State, class Reducer, class Range>
+struct is_batch_reducible<State, Reducer, Range, std::enable_if_t<is_contiguous_range<Range>::value>>
+    : has_step_batch<start_result_t<Reducer>, State, span_t<contiguous_item_t<Range>>>
+{
+};
+
+template <class State, class Reducer, class... Ranges>
+auto reduce_ranges(const run_context& context, State state, const Reducer& reducer, Ranges&&... ranges) -> State
+{
+    if constexpr (
+        sizeof...(Ranges) == 1 && (is_simd_reducible<State, Reducer, std::remove_reference_t<Ranges>>::value && ...))
+    {
+        const auto op = simd_traits<Reducer>::op(reducer);
+        const auto projection = simd_traits<Reducer>::projection(reducer);
+        return simd_reduce(std::data(ranges)..., std::size(ranges)..., std::move(state), op, projection);
+    }
+    else if constexpr (
+        sizeof...(Ranges) == 1 && (is_batch_reducible<State, Reducer, std::remove_reference_t<Ranges>>::value && ...))
+    {
+        auto run = start(reducer, context);
+        (run.step_batch(
+             state, span_t<contiguous_item_t<std::remove_reference_t<Ranges>>>{ std::data(ranges), std::size(ranges) }),
+         ...);
+        complete(run, state);
+        return state;
+    }
+    else if constexpr ((is_random_access_range<std::remove_reference_t<Ranges>>::value && ...))
+    {
+        // With the shortest length known upfront a single index drives all the ranges.
+        auto run = start(reducer, context);
+        const auto begin = std::tuple{ std::begin(ranges)... };
+        const std::ptrdiff_t size = std::min({ static_cast<std::ptrdiff_t>(std::end(ranges) - std::begin(ranges))... });
+        for (std::ptrdiff_t i = 0; i < size && !is_done(run); ++i)
+        {
+            std::apply([&](const auto&... it) { step(run, state, it[i]...); }, begin);
+        }
+        complete(run, state);
+        return state;
+    }
+    else
+    {
+        auto run = start(reducer, context);
+        const auto begin = std::tuple{ std::begin(ranges)... };
+        const auto end = std::tuple{ std::end(ranges)... };
+        for (auto it = begin; !eq(it, end) && !is_done(run); inc(it))
+        {
+            invoke_reducer(run, state, it);
+        }
+        complete(run, state);
+        return state;
+    }
+}
+
 struct reduce_fn
 {
     template <class State, class Reducer>
@@ -59,18 +145,18 @@ struct reduce_fn
     {
         State m_state;
         Reducer m_reducer;
+        arena* m_arena = nullptr;
 
         template <class... Ranges>
         auto operator()(Ranges&&... ranges) const -> State
         {
-            State state = m_state;
-            const auto begin = std::tuple{ std::begin(ranges)... };
-            const auto end = std::tuple{ std::end(ranges)... };
-            for (auto it = begin; !eq(it, end); inc(it))
+            if (!m_arena)
             {
-                state = invoke_reducer(m_reducer, std::move(state), it);
+                return reduce_ranges(run_context{}, m_state, m_reducer, std::forward<Ranges>(ranges)...);
             }
-            return state;
+            State result = reduce_ranges(m_arena->context(), m_state, m_reducer, std::forward<Ranges>(ranges)...);
+            m_arena->release();
+            return result;
         }
 
         template <class Range>
@@ -97,6 +183,20 @@ struct reduce_fn
     {
         return { std::move(state), std::forward<Reducer>(reducer) };
     }
+
+    // The runs take their buffers from `memory`, which is released once each reduction is over; the state returned
+    // must not hold on to memory of the arena.
+    template <class State, class Reducer>
+    constexpr auto operator()(State state, Reducer&& reducer, arena& memory) const -> proxy_t<State, std::decay_t<Reducer>>
+    {
+        return { std::move(state), std::forward<Reducer>(reducer), &memory };
+    }
+
+    template <class Reducer>
+    constexpr auto operator()(Reducer&& reducer) const -> proxy_t<decltype(init(reducer)), std::decay_t<Reducer>>
+    {
+        return { init(reducer), std::forward<Reducer>(reducer) };
+    }
 };
 
 static constexpr inline auto reduce = reduce_fn{};
@@ -118,12 +218,65 @@ struct copy_fn
 
 static constexpr inline auto copy = copy_fn{};
 
+template <class Container, class = void>
+struct has_reserve : std::false_type
+{
+};
+
+template <class Container>
+struct has_reserve<Container, std::void_t<decltype(std::declval<Container&>().reserve(std::size_t{}))>> : std::true_type
+{
+};
+
+template <class Container, class = void>
+struct has_capacity : std::false_type
+{
+};
+
+template <class Container>
+struct has_capacity<Container, std::void_t<decltype(std::declval<const Container&>().capacity())>> : std::true_type
+{
+};
+
+template <class Range, class = void>
+struct has_size : std::false_type
+{
+};
+
+template <class Range>
+struct has_size<Range, std::void_t<decltype(std::size(std::declval<Range&>()))>> : std::true_type
+{
+};
+
 struct into_fn
 {
     template <class Result, class Transducer, class... Ranges>
     auto operator()(Result&& result, Transducer&& transducer, Ranges&&... ranges) const -> Result&&
     {
-        copy(std::back_inserter(result), std::forward<Transducer>(transducer))(std::forward<Ranges>(ranges)...);
+        using container_type = std::remove_reference_t<Result>;
+        const auto reducer = std::invoke(std::forward<Transducer>(transducer), emplace_back);
+        if constexpr (
+            has_reserve<container_type>::value && sizeof...(Ranges) > 0
+            && (has_size<std::remove_reference_t<Ranges>>::value && ...))
+        {
+            if (const auto hint = size_hint(reducer, std::min({ static_cast<std::size_t>(std::size(ranges))... })))
+            {
+                // Appending to a container over and over must not give up its geometric growth.
+                const std::size_t needed = result.size() + *hint;
+                if constexpr (has_capacity<container_type>::value)
+                {
+                    if (needed > result.capacity())
+                    {
+                        result.reserve(std::max(needed, 2 * result.capacity()));
+                    }
+                }
+                else
+                {
+                    result.reserve(needed);
+                }
+            }
+        }
+        reduce_ranges(run_context{}, std::addressof(result), reducer, std::forward<Ranges>(ranges)...);
         return std::forward<Result>(result);
     }
 };
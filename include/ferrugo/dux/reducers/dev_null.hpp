@@ -13,9 +13,8 @@ namespace detail
 struct dev_null_fn
 {
     template <class State, class... Args>
-    constexpr auto operator()(State state, Args&&... args) const -> State
+    constexpr void operator()(State&, Args&&...) const
     {
-        return state;
     }
 };
 
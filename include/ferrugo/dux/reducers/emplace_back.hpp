@@ -0,0 +1,50 @@
+#pragma once
+
+#include <ferrugo/dux/interfaces.hpp>
+#include <ferrugo/dux/to_tuple.hpp>
+#include <type_traits>
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+template <class Container, class = void, class... Args>
+struct has_emplace_back : std::false_type
+{
+};
+
+template <class Container, class... Args>
+struct has_emplace_back<
+    Container,
+    std::void_t<decltype(std::declval<Container&>().emplace_back(std::declval<Args>()...))>,
+    Args...> : std::true_type
+{
+};
+
+// Appends every item to the container pointed to by the state, constructing it in place when the container allows.
+struct emplace_back_fn
+{
+    template <class Container, class... Args>
+    constexpr auto operator()(Container* container, Args&&... args) const -> Container*
+    {
+        if constexpr (has_emplace_back<Container, void, Args&&...>::value)
+        {
+            container->emplace_back(std::forward<Args>(args)...);
+        }
+        else
+        {
+            container->push_back(to_tuple(std::forward<Args>(args)...));
+        }
+        return container;
+    }
+};
+
+}  // namespace detail
+
+static constexpr inline auto emplace_back = reducer_interface_t{ detail::emplace_back_fn{} };
+
+}  // namespace dux
+}  // namespace ferrugo
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <ferrugo/dux/interfaces.hpp>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace ferrugo
 {
@@ -17,22 +19,126 @@ struct fork_fn
     {
         std::tuple<Reducers...> m_reducers;
 
-        template <std::size_t N, class State, class... Args>
-        auto call(State state, Args&&... args) const -> State
+        struct run_t
         {
-            state = std::invoke(std::get<N>(m_reducers), std::move(state), args...);
-            if constexpr (N + 1 < sizeof...(Reducers))
+            static constexpr bool stateless = all_stateless_runs<start_result_t<Reducers>...>;
+
+            std::tuple<start_result_t<Reducers>...> m_runs;
+
+            template <class State, class... Args>
+            void operator()(State& state, Args&&... args)
+            {
+                std::apply(
+                    [&](auto&... runs)
+                    {
+                        (..., (is_done(runs) ? void() : step(runs, state, args...)));
+                    },
+                    m_runs);
+            }
+
+            constexpr bool done() const
+            {
+                return std::apply([](const auto&... runs) { return (... && is_done(runs)); }, m_runs);
+            }
+
+            template <class State>
+            void complete(State& state)
+            {
+                std::apply([&](auto&... runs) { (..., detail::complete(runs, state)); }, m_runs);
+            }
+        };
+
+        auto start(const run_context& context = {}) const -> run_t
+        {
+            return { std::apply(
+                [&](const auto&... reducers) { return std::tuple{ detail::start(reducers, context)... }; },
+                m_reducers) };
+        }
+    };
+
+    template <class... Reducers>
+    constexpr auto operator()(Reducers&&... reducers) const -> reducer_interface_t<reducer_t<std::decay_t<Reducers>...>>
+    {
+        return { { std::tuple<std::decay_t<Reducers>...>{ std::forward<Reducers>(reducers)... } } };
+    }
+};
+
+struct tee_fn
+{
+    template <class... Reducers>
+    struct reducer_t
+    {
+        std::tuple<Reducers...> m_reducers;
+
+        struct run_t
+        {
+            static constexpr bool stateless = all_stateless_runs<start_result_t<Reducers>...>;
+
+            std::tuple<start_result_t<Reducers>...> m_runs;
+
+            template <class State, class... Args>
+            void operator()(State& state, Args&&... args)
+            {
+                call(state, std::index_sequence_for<Reducers...>{}, std::forward<Args>(args)...);
+            }
+
+            constexpr bool done() const
+            {
+                return std::apply([](const auto&... runs) { return (... && is_done(runs)); }, m_runs);
+            }
+
+            template <class State>
+            void complete(State& state)
+            {
+                complete(state, std::index_sequence_for<Reducers...>{});
+            }
+
+        private:
+            template <class State, std::size_t... I, class... Args>
+            void call(State& state, std::index_sequence<I...>, Args&&... args)
+            {
+                static_assert(std::tuple_size_v<State> == sizeof...(Reducers), "tee expects one state per branch");
+                (..., call_branch<I>(std::get<I>(state), std::forward<Args>(args)...));
+            }
+
+            // Every branch but the last sees the arguments as lvalues; the last one may take them over.
+            template <std::size_t I, class BranchState, class... Args>
+            void call_branch(BranchState& state, Args&&... args)
+            {
+                auto& run = std::get<I>(m_runs);
+                if (is_done(run))
+                {
+                    return;
+                }
+                if constexpr (I + 1 == sizeof...(Reducers))
+                {
+                    step(run, state, std::forward<Args>(args)...);
+                }
+                else
+                {
+                    step(run, state, args...);
+                }
+            }
+
+            template <class State, std::size_t... I>
+            void complete(State& state, std::index_sequence<I...>)
             {
-                state = call<N + 1>(std::move(state), args...);
+                (..., detail::complete(std::get<I>(m_runs), std::get<I>(state)));
             }
+        };
 
-            return state;
+        auto start(const run_context& context = {}) const -> run_t
+        {
+            return { std::apply(
+                [&](const auto&... reducers) { return std::tuple{ detail::start(reducers, context)... }; },
+                m_reducers) };
         }
 
-        template <class State, class... Args>
-        auto operator()(State state, Args&&... args) const -> State
+        template <bool B = true>
+        constexpr auto init() const
+            -> std::tuple<decltype(detail::init(std::declval<const std::conditional_t<B, Reducers, Reducers>&>()))...>
         {
-            return call<0>(std::move(state), args...);
+            return std::apply([](const auto&... reducers) { return std::tuple{ detail::init(reducers)... }; }, m_reducers);
         }
     };
 
@@ -47,5 +153,9 @@ struct fork_fn
 
 static constexpr inline auto fork = detail::fork_fn{};
 
+// Feeds every item to all `reducers`, each one accumulating into its own element of a tuple-like state, so that
+// several aggregates are computed in a single pass.
+static constexpr inline auto tee = detail::tee_fn{};
+
 }  // namespace dux
 }  // namespace ferrugo
\ No newline at end of file
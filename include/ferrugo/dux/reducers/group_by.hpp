@@ -0,0 +1,194 @@
+#pragma once
+
+#include <ferrugo/dux/flat_table.hpp>
+#include <ferrugo/dux/interfaces.hpp>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+struct group_by_fn
+{
+    // Stands for the value initialized `mapped_type` of the map as the initial state of a group.
+    struct default_init_t
+    {
+    };
+
+    template <class KeyFn, class Reducer, class Init>
+    struct reducer_t
+    {
+        KeyFn m_key_fn;
+        Reducer m_reducer;
+        Init m_init;
+
+        using sub_run_type = start_result_t<Reducer>;
+
+        // Runs of the groups of one map, keyed like it; the key type is only known once the map is.
+        struct groups_base_t
+        {
+            virtual ~groups_base_t() = default;
+        };
+
+        template <class Key>
+        struct groups_t : groups_base_t
+        {
+            flat_map<Key, sub_run_type> m_runs;
+
+            explicit groups_t(std::pmr::memory_resource* resource) : m_runs{ 0, resource }
+            {
+            }
+        };
+
+        struct run_t
+        {
+            // Without state in the runs of the groups, every item is stepped through a run of its own.
+            static constexpr bool stateless = is_stateless_run<sub_run_type>::value;
+
+            const reducer_t* m_reducer;
+            run_context m_context;
+            std::unique_ptr<groups_base_t> m_groups = {};
+
+            template <class Map, class... Args>
+            void operator()(Map& state, Args&&... args)
+            {
+                typename Map::key_type key = std::invoke(m_reducer->m_key_fn, std::as_const(args)...);
+                auto& group = m_reducer->emplace_group(state, key);
+                if constexpr (stateless)
+                {
+                    auto run = detail::start(m_reducer->m_reducer, m_context);
+                    step(run, group, std::forward<Args>(args)...);
+                }
+                else
+                {
+                    auto& runs = group_runs<typename Map::key_type>();
+                    auto it = runs.find(key);
+                    if (it == runs.end())
+                    {
+                        it = runs.try_emplace(std::move(key), detail::start(m_reducer->m_reducer, m_context)).first;
+                    }
+                    if (!is_done(it->second))
+                    {
+                        step(it->second, group, std::forward<Args>(args)...);
+                    }
+                }
+            }
+
+            template <class Map>
+            void complete(Map& state)
+            {
+                if constexpr (stateless)
+                {
+                    for (auto& entry : state)
+                    {
+                        auto run = detail::start(m_reducer->m_reducer, m_context);
+                        detail::complete(run, entry.second);
+                    }
+                }
+                else if (m_groups)
+                {
+                    for (auto& entry : group_runs<typename Map::key_type>())
+                    {
+                        detail::complete(entry.second, state.find(entry.first)->second);
+                    }
+                }
+            }
+
+        private:
+            template <class Key>
+            auto group_runs() -> flat_map<Key, sub_run_type>&
+            {
+                if (!m_groups)
+                {
+                    m_groups = std::make_unique<groups_t<Key>>(m_context.resource);
+                }
+                return static_cast<groups_t<Key>&>(*m_groups).m_runs;
+            }
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { this, context };
+        }
+
+    private:
+        template <class Map, class Key>
+        auto emplace_group(Map& state, Key&& key) const -> typename Map::mapped_type&
+        {
+            if constexpr (std::is_same_v<Init, default_init_t>)
+            {
+                return state.try_emplace(std::forward<Key>(key)).first->second;
+            }
+            else
+            {
+                return state.try_emplace(std::forward<Key>(key), m_init).first->second;
+            }
+        }
+    };
+
+    template <class KeyFn, class Reducer>
+    constexpr auto operator()(KeyFn&& key_fn, Reducer&& reducer) const
+        -> reducer_interface_t<reducer_t<std::decay_t<KeyFn>, std::decay_t<Reducer>, default_init_t>>
+    {
+        return { { std::forward<KeyFn>(key_fn), std::forward<Reducer>(reducer), default_init_t{} } };
+    }
+
+    template <class KeyFn, class Init, class Reducer>
+    constexpr auto operator()(KeyFn&& key_fn, Init init, Reducer&& reducer) const
+        -> reducer_interface_t<reducer_t<std::decay_t<KeyFn>, std::decay_t<Reducer>, Init>>
+    {
+        return { { std::forward<KeyFn>(key_fn), std::forward<Reducer>(reducer), std::move(init) } };
+    }
+};
+
+struct merge_groups_fn
+{
+    template <class Op>
+    struct combine_t
+    {
+        Op m_op;
+
+        template <class Map>
+        auto operator()(Map lhs, Map rhs) const -> Map
+        {
+            lhs.reserve(lhs.size() + rhs.size());
+            for (auto& entry : rhs)
+            {
+                const auto [it, inserted] = lhs.try_emplace(std::move(entry.first), std::move(entry.second));
+                if (!inserted)
+                {
+                    it->second = std::invoke(m_op, std::move(it->second), std::move(entry.second));
+                }
+            }
+            return lhs;
+        }
+    };
+
+    template <class Op>
+    constexpr auto operator()(Op&& op) const -> combine_t<std::decay_t<Op>>
+    {
+        return { std::forward<Op>(op) };
+    }
+};
+
+}  // namespace detail
+
+// Reducer routing every item to the state of its group, a map entry under the key `key_fn(item)`, and reducing it
+// there with `reducer`. New groups start from `init`, or from a value initialized `mapped_type` when it is not
+// given. The state is the map itself, usually a `flat_map` reserved for the expected number of keys; any map with
+// `try_emplace` works. Each group keeps a run of `reducer` of its own, completed when the reduction is, so stages
+// that count or buffer (e.g. `take`, `chunk`) apply per group.
+static constexpr inline auto group_by = detail::group_by_fn{};
+
+// Combination of two maps built by `group_by`, e.g. for `parallel_reduce`: the groups of both are kept, those present
+// in both have their states combined with `op(lhs_state, rhs_state)`.
+static constexpr inline auto merge_groups = detail::merge_groups_fn{};
+
+}  // namespace dux
+}  // namespace ferrugo
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <ferrugo/dux/interfaces.hpp>
+#include <ferrugo/dux/simd.hpp>
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+struct minimum_fn
+{
+    template <class State, class Arg>
+    constexpr auto operator()(State state, Arg&& arg) const -> State
+    {
+        return arg < state ? State(std::forward<Arg>(arg)) : state;
+    }
+};
+
+struct maximum_fn
+{
+    template <class State, class Arg>
+    constexpr auto operator()(State state, Arg&& arg) const -> State
+    {
+        return state < arg ? State(std::forward<Arg>(arg)) : state;
+    }
+};
+
+template <>
+struct simd_traits<minimum_fn> : simd_op_traits<minimum_fn>
+{
+};
+
+template <>
+struct simd_traits<maximum_fn> : simd_op_traits<maximum_fn>
+{
+};
+
+}  // namespace detail
+
+static constexpr inline auto minimum = reducer_interface_t{ detail::minimum_fn{} };
+static constexpr inline auto maximum = reducer_interface_t{ detail::maximum_fn{} };
+
+}  // namespace dux
+}  // namespace ferrugo
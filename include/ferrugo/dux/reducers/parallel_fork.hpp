@@ -0,0 +1,148 @@
+#pragma once
+
+#include <exception>
+#include <ferrugo/dux/interfaces.hpp>
+#include <ferrugo/dux/worker.hpp>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+template <class T>
+struct parallel_fork_fn
+{
+    template <class State, class Reducers, class Indices>
+    struct pipeline_t;
+
+    template <class State, class... Reducers, std::size_t... I>
+    struct pipeline_t<State, std::tuple<Reducers...>, std::index_sequence<I...>> : worker_base_t<T>
+    {
+        std::tuple<std::unique_ptr<batch_worker_t<T, Reducers, std::tuple_element_t<I, State>>>...> m_branches;
+
+        pipeline_t(
+            const std::tuple<Reducers...>& reducers, State& state, std::size_t queue_size, const run_context& context)
+            : m_branches{ std::make_unique<batch_worker_t<T, Reducers, std::tuple_element_t<I, State>>>(
+                std::get<I>(reducers), std::move(std::get<I>(state)), queue_size, context)... }
+        {
+        }
+
+        void push(const batch_t<T>& batch) override
+        {
+            (..., std::get<I>(m_branches)->push(batch));
+        }
+
+        bool done() const override
+        {
+            return (... && std::get<I>(m_branches)->done());
+        }
+
+        // Waits for every branch, then hands the final states back or rethrows the first failure.
+        void finish(State& state)
+        {
+            (..., std::get<I>(m_branches)->join());
+            std::exception_ptr error;
+            (..., (error = error ? error : std::get<I>(m_branches)->error()));
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+            (..., (std::get<I>(state) = std::get<I>(m_branches)->take_state()));
+        }
+    };
+
+    template <class... Reducers>
+    struct reducer_t
+    {
+        std::tuple<Reducers...> m_reducers;
+        batch_options m_options;
+
+        struct run_t
+        {
+            const reducer_t* m_reducer;
+            run_context m_context;
+            batch_sender_t<T> m_sender;
+
+            template <class State, class... Args>
+            void operator()(State& state, Args&&... args)
+            {
+                pipeline<State>(state);
+                m_sender.add(std::forward<Args>(args)...);
+            }
+
+            bool done() const
+            {
+                return m_sender.m_done;
+            }
+
+            template <class State>
+            void complete(State& state)
+            {
+                auto& p = pipeline<State>(state);
+                m_sender.flush();
+                p.finish(state);
+                m_sender.m_worker.reset();
+            }
+
+        private:
+            template <class State>
+            using pipeline_type = pipeline_t<State, std::tuple<Reducers...>, std::index_sequence_for<Reducers...>>;
+
+            // The branch threads are started on the first item, once the state they take over is known.
+            template <class State>
+            auto pipeline(State& state) -> pipeline_type<State>&
+            {
+                static_assert(
+                    std::tuple_size_v<State> == sizeof...(Reducers), "parallel_fork expects one state per branch");
+                if (!m_sender.m_worker)
+                {
+                    m_sender.m_worker = std::make_unique<pipeline_type<State>>(
+                        m_reducer->m_reducers, state, m_reducer->m_options.queue_size, m_context);
+                }
+                return static_cast<pipeline_type<State>&>(*m_sender.m_worker);
+            }
+        };
+
+        auto start(const run_context& context = {}) const -> run_t
+        {
+            return run_t{ this, context, batch_sender_t<T>{ m_options } };
+        }
+
+        template <bool B = true>
+        constexpr auto init() const
+            -> std::tuple<decltype(detail::init(std::declval<const std::conditional_t<B, Reducers, Reducers>&>()))...>
+        {
+            return std::apply([](const auto&... reducers) { return std::tuple{ detail::init(reducers)... }; }, m_reducers);
+        }
+    };
+
+    template <class... Reducers>
+    auto operator()(batch_options options, Reducers&&... reducers) const
+        -> reducer_interface_t<reducer_t<std::decay_t<Reducers>...>>
+    {
+        return { { std::tuple<std::decay_t<Reducers>...>{ std::forward<Reducers>(reducers)... }, normalize(options) } };
+    }
+
+    template <class... Reducers>
+    auto operator()(Reducers&&... reducers) const -> reducer_interface_t<reducer_t<std::decay_t<Reducers>...>>
+    {
+        return (*this)(batch_options{}, std::forward<Reducers>(reducers)...);
+    }
+};
+
+}  // namespace detail
+
+// Like `tee`, but every branch runs on a thread of its own. Items, copied as `T`, are handed to the branches in
+// batches through bounded single-producer single-consumer queues; a full queue stalls the producer. Each branch
+// takes over its element of the tuple-like state on the first item and gives it back on completion.
+template <class T>
+static constexpr inline auto parallel_fork = detail::parallel_fork_fn<T>{};
+
+}  // namespace dux
+}  // namespace ferrugo
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <ferrugo/dux/identity.hpp>
+#include <ferrugo/dux/interfaces.hpp>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+template <bool Top>
+struct select_k_fn
+{
+    // Tells whether `lhs` ranks before `rhs`: the greater one first for `top_k`, the lesser one for `bottom_k`.
+    template <class Compare, class Proj>
+    struct order_t
+    {
+        Compare m_compare;
+        Proj m_proj;
+
+        template <class L, class R>
+        bool operator()(const L& lhs, const R& rhs) const
+        {
+            if constexpr (Top)
+            {
+                return std::invoke(m_compare, std::invoke(m_proj, rhs), std::invoke(m_proj, lhs));
+            }
+            else
+            {
+                return std::invoke(m_compare, std::invoke(m_proj, lhs), std::invoke(m_proj, rhs));
+            }
+        }
+    };
+
+    // Drops all but the first `count` items in the order, leaving the last one kept at `count - 1`.
+    template <class Container, class Order>
+    static void keep_first(Container& items, std::size_t count, const Order& order)
+    {
+        if (count == 0)
+        {
+            items.clear();
+        }
+        else if (items.size() > count)
+        {
+            std::nth_element(items.begin(), items.begin() + (count - 1), items.end(), order);
+            items.erase(items.begin() + count, items.end());
+        }
+    }
+
+    template <class Compare, class Proj>
+    struct reducer_t
+    {
+        std::size_t m_count;
+        order_t<Compare, Proj> m_order;
+
+        // Items are appended to the state until it holds twice the count, then cut down to the count. Once it has
+        // been cut, an item ranking after the last one kept can not make it and is rejected with a single comparison.
+        struct run_t
+        {
+            const reducer_t* m_reducer;
+            bool m_cut = false;
+
+            template <class Container, class Arg>
+            void operator()(Container& state, Arg&& arg)
+            {
+                const std::size_t count = m_reducer->m_count;
+                if (count == 0 || (m_cut && !m_reducer->m_order(arg, state[count - 1])))
+                {
+                    return;
+                }
+                if (state.capacity() < 2 * count)
+                {
+                    state.reserve(2 * count);
+                }
+                state.emplace_back(std::forward<Arg>(arg));
+                if (state.size() >= 2 * count)
+                {
+                    keep_first(state, count, m_reducer->m_order);
+                    m_cut = true;
+                }
+            }
+
+            template <class Container>
+            void complete(Container& state)
+            {
+                keep_first(state, m_reducer->m_count, m_reducer->m_order);
+                std::sort(state.begin(), state.end(), m_reducer->m_order);
+            }
+        };
+
+        auto start() const -> run_t
+        {
+            return run_t{ this };
+        }
+    };
+
+    template <class Compare, class Proj>
+    struct merge_t
+    {
+        std::size_t m_count;
+        order_t<Compare, Proj> m_order;
+
+        template <class Container>
+        auto operator()(Container lhs, Container rhs) const -> Container
+        {
+            lhs.insert(lhs.end(), std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+            keep_first(lhs, m_count, m_order);
+            std::sort(lhs.begin(), lhs.end(), m_order);
+            return lhs;
+        }
+    };
+
+    template <class Compare = std::less<>, class Proj = identity_fn>
+    constexpr auto operator()(std::size_t count, Compare compare = {}, Proj proj = {}) const
+        -> reducer_interface_t<reducer_t<Compare, Proj>>
+    {
+        return { { count, { std::move(compare), std::move(proj) } } };
+    }
+
+    // Combination of two results of the reducer, e.g. for `parallel_reduce`.
+    template <class Compare = std::less<>, class Proj = identity_fn>
+    static constexpr auto merge(std::size_t count, Compare compare = {}, Proj proj = {}) -> merge_t<Compare, Proj>
+    {
+        return { count, { std::move(compare), std::move(proj) } };
+    }
+};
+
+}  // namespace detail
+
+// Reducers collecting the `count` greatest (`top_k`) or least (`bottom_k`) items by `compare` applied to
+// `proj(item)`, into a sequence container given as the state, e.g. a `std::vector`. The state never grows beyond
+// twice the count, whatever the number of items, and holds the result ordered best first once the reduction is
+// complete; the order of equivalent items is unspecified. `top_k.merge(count, compare, proj)` (likewise for
+// `bottom_k`) combines two results into one.
+static constexpr inline auto top_k = detail::select_k_fn<true>{};
+static constexpr inline auto bottom_k = detail::select_k_fn<false>{};
+
+}  // namespace dux
+}  // namespace ferrugo
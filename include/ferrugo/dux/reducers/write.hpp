@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <ferrugo/dux/interfaces.hpp>
+#include <memory_resource>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <system_error>
+
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+struct ostream_writer_t
+{
+    std::ostream* m_stream;
+
+    void operator()(std::string_view head, std::string_view tail) const
+    {
+        m_stream->write(head.data(), static_cast<std::streamsize>(head.size()));
+        m_stream->write(tail.data(), static_cast<std::streamsize>(tail.size()));
+    }
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+// Writes both parts with a single `writev` call, resuming after partial writes and interrupted calls.
+struct fd_writer_t
+{
+    int m_fd;
+
+    void operator()(std::string_view head, std::string_view tail) const
+    {
+        ::iovec parts[2] = { { const_cast<char*>(head.data()), head.size() },
+                             { const_cast<char*>(tail.data()), tail.size() } };
+        ::iovec* part = parts;
+        int count = 2;
+        while (count > 0)
+        {
+            if (part->iov_len == 0)
+            {
+                ++part;
+                --count;
+                continue;
+            }
+            const ::ssize_t result = ::writev(m_fd, part, count);
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::system_error{ errno, std::generic_category(), "writev" };
+            }
+            auto written = static_cast<std::size_t>(result);
+            while (count > 0 && written >= part->iov_len)
+            {
+                written -= part->iov_len;
+                ++part;
+                --count;
+            }
+            if (count > 0)
+            {
+                part->iov_base = static_cast<char*>(part->iov_base) + written;
+                part->iov_len -= written;
+            }
+        }
+    }
+};
+#endif
+
+template <class Writer>
+struct write_fn
+{
+    struct reducer_t
+    {
+        Writer m_writer;
+        std::size_t m_buffer_size;
+
+        // Bytes still buffered when the run is dropped without being completed, e.g. when the reduction throws or a
+        // reducer is driven through `start()` by hand, are written out by the destructor on a best-effort basis.
+        struct run_t
+        {
+            Writer m_writer;
+            std::pmr::vector<char> m_buffer;
+            std::size_t m_used = 0;
+
+            run_t(Writer writer, std::pmr::vector<char> buffer)
+                : m_writer{ std::move(writer) }
+                , m_buffer{ std::move(buffer) }
+            {
+            }
+
+            run_t(run_t&& other) noexcept
+                : m_writer{ std::move(other.m_writer) }
+                , m_buffer{ std::move(other.m_buffer) }
+                , m_used{ std::exchange(other.m_used, 0) }
+            {
+            }
+
+            auto operator=(run_t&&) -> run_t& = delete;
+
+            ~run_t()
+            {
+                try
+                {
+                    flush({});
+                }
+                catch (...)
+                {
+                }
+            }
+
+            template <class State, class... Args>
+            void operator()(State&, const Args&... args)
+            {
+                (append(args), ...);
+            }
+
+            template <class State>
+            void complete(State&)
+            {
+                flush({});
+            }
+
+        private:
+            template <class T>
+            void append(const T& item)
+            {
+                if constexpr (std::is_same_v<T, char>)
+                {
+                    put(std::string_view(&item, 1));
+                }
+                else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+                {
+                    put(std::string_view(item));
+                }
+                else
+                {
+                    static_assert(
+                        std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                        "write_to accepts characters, strings and numbers");
+                    char text[64];
+                    const auto result = std::to_chars(std::begin(text), std::end(text), item);
+                    put(std::string_view(text, static_cast<std::size_t>(result.ptr - text)));
+                }
+            }
+
+            void put(std::string_view text)
+            {
+                if (m_used + text.size() <= m_buffer.size())
+                {
+                    std::memcpy(m_buffer.data() + m_used, text.data(), text.size());
+                    m_used += text.size();
+                }
+                else if (text.size() >= m_buffer.size())
+                {
+                    flush(text);
+                }
+                else
+                {
+                    flush({});
+                    put(text);
+                }
+            }
+
+            // Writes out the buffered bytes followed by `tail`, which large items pass directly to avoid a copy.
+            void flush(std::string_view tail)
+            {
+                if (m_used > 0 || !tail.empty())
+                {
+                    m_writer(std::string_view(m_buffer.data(), m_used), tail);
+                    m_used = 0;
+                }
+            }
+        };
+
+        auto start(const run_context& context = {}) const -> run_t
+        {
+            return run_t{ m_writer, std::pmr::vector<char>(m_buffer_size, context.resource) };
+        }
+    };
+};
+
+struct write_to_fn
+{
+    static constexpr inline std::size_t default_buffer_size = std::size_t{ 1 } << 16;
+
+    auto operator()(std::ostream& stream, std::size_t buffer_size = default_buffer_size) const
+        -> reducer_interface_t<write_fn<ostream_writer_t>::reducer_t>
+    {
+        return { { ostream_writer_t{ &stream }, std::max(buffer_size, std::size_t{ 1 }) } };
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    auto operator()(int fd, std::size_t buffer_size = default_buffer_size) const
+        -> reducer_interface_t<write_fn<fd_writer_t>::reducer_t>
+    {
+        return { { fd_writer_t{ fd }, std::max(buffer_size, std::size_t{ 1 }) } };
+    }
+#endif
+};
+
+}  // namespace detail
+
+// Sink serializing characters, strings and numbers into a buffer of `buffer_size` bytes that is written out
+// whenever it fills up and once more on completion. The state is passed through unchanged.
+static constexpr inline auto write_to = detail::write_to_fn{};
+
+}  // namespace dux
+}  // namespace ferrugo
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <ferrugo/dux/identity.hpp>
+#include <ferrugo/dux/interfaces.hpp>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FERRUGO_DUX_SIMD_X86 1
+#else
+#define FERRUGO_DUX_SIMD_X86 0
+#endif
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+// Describes a reducer whose steps may be regrouped freely: `op(reducer)` returns the associative and commutative
+// binary operation it applies, `projection(reducer)` the function mapping each input to the operand.
+// Specialized for the standard arithmetic function objects here and by the reducers and transducers that qualify.
+template <class Reducer, class = void>
+struct simd_traits
+{
+    static constexpr bool enabled = false;
+};
+
+template <class Impl>
+struct simd_traits<reducer_interface_t<Impl>> : simd_traits<Impl>
+{
+    static constexpr auto op(const reducer_interface_t<Impl>& reducer)
+    {
+        return simd_traits<Impl>::op(reducer.m_impl);
+    }
+
+    static constexpr auto projection(const reducer_interface_t<Impl>& reducer)
+    {
+        return simd_traits<Impl>::projection(reducer.m_impl);
+    }
+};
+
+template <class Op>
+struct simd_op_traits
+{
+    static constexpr bool enabled = true;
+
+    static constexpr auto op(const Op& op) -> const Op&
+    {
+        return op;
+    }
+
+    static constexpr auto projection(const Op&) -> identity_fn
+    {
+        return {};
+    }
+};
+
+template <class T>
+struct simd_traits<std::plus<T>> : simd_op_traits<std::plus<T>>
+{
+};
+
+template <class T>
+struct simd_traits<std::multiplies<T>> : simd_op_traits<std::multiplies<T>>
+{
+};
+
+template <class T>
+static constexpr inline bool is_simd_arithmetic_v
+    = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) >= sizeof(int);
+
+template <class Range, class = void>
+struct is_contiguous_range : std::false_type
+{
+};
+
+template <class Range>
+struct is_contiguous_range<
+    Range,
+    std::void_t<decltype(std::data(std::declval<Range&>())), decltype(std::size(std::declval<Range&>()))>>
+    : std::is_pointer<decltype(std::data(std::declval<Range&>()))>
+{
+};
+
+template <class State, class Reducer, class Range, class = void>
+struct is_simd_reducible : std::false_type
+{
+};
+
+// The fast path applies when reducing a single contiguous range of arithmetic values whose projection yields the
+// state type itself, so that every step is `state = op(state, projection(item))` without any conversion.
+template <class State, class Reducer, class Range>
+struct is_simd_reducible<
+    State,
+    Reducer,
+    Range,
+    std::enable_if_t<simd_traits<Reducer>::enabled && is_contiguous_range<Range>::value>>
+{
+    using item_type = decltype(*std::data(std::declval<Range&>()));
+    using op_type = decltype(simd_traits<Reducer>::op(std::declval<const Reducer&>()));
+    using projection_type = decltype(simd_traits<Reducer>::projection(std::declval<const Reducer&>()));
+
+    static constexpr bool value = is_simd_arithmetic_v<std::decay_t<item_type>>  //
+                                  && is_simd_arithmetic_v<State>
+                                  && std::is_same_v<std::decay_t<std::invoke_result_t<projection_type, item_type>>, State>
+                                  && std::is_same_v<std::invoke_result_t<op_type, State, State>, State>;
+};
+
+// Keeps `Lanes` independent partial results so that the compiler can map them onto vector registers.
+// Floating point results may differ from the sequential loop in rounding, as with std::reduce.
+template <std::size_t Lanes, class State, class T, class Op, class Proj>
+inline auto simd_reduce_lanes(const T* data, std::size_t size, State state, const Op& op, const Proj& proj) -> State
+{
+    std::size_t i = 0;
+    if (size >= Lanes)
+    {
+        State lanes[Lanes];
+        for (std::size_t j = 0; j < Lanes; ++j)
+        {
+            lanes[j] = std::invoke(proj, data[j]);
+        }
+        for (i = Lanes; i + Lanes <= size; i += Lanes)
+        {
+            for (std::size_t j = 0; j < Lanes; ++j)
+            {
+                lanes[j] = std::invoke(op, lanes[j], std::invoke(proj, data[i + j]));
+            }
+        }
+        for (std::size_t j = 0; j < Lanes; ++j)
+        {
+            state = std::invoke(op, state, lanes[j]);
+        }
+    }
+    for (; i < size; ++i)
+    {
+        state = std::invoke(op, state, std::invoke(proj, data[i]));
+    }
+    return state;
+}
+
+#if FERRUGO_DUX_SIMD_X86
+template <class State, class T, class Op, class Proj>
+__attribute__((target("avx2"))) inline auto simd_reduce_avx2(
+    const T* data, std::size_t size, State state, const Op& op, const Proj& proj) -> State
+{
+    return simd_reduce_lanes<4 * 32 / sizeof(State)>(data, size, std::move(state), op, proj);
+}
+
+inline bool has_avx2()
+{
+    static const bool result = __builtin_cpu_supports("avx2");
+    return result;
+}
+#endif
+
+template <class State, class T, class Op, class Proj>
+inline auto simd_reduce(const T* data, std::size_t size, State state, const Op& op, const Proj& proj) -> State
+{
+#if FERRUGO_DUX_SIMD_X86
+    if (has_avx2())
+    {
+        return simd_reduce_avx2(data, size, std::move(state), op, proj);
+    }
+#endif
+    return simd_reduce_lanes<4 * 16 / sizeof(State)>(data, size, std::move(state), op, proj);
+}
+
+}  // namespace detail
+}  // namespace dux
+}  // namespace ferrugo
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+struct columns_fn
+{
+    template <class Table, class... Members, std::enable_if_t<(std::is_member_object_pointer_v<Members> && ...), int> = 0>
+    constexpr auto operator()(Table& table, Members... members) const
+    {
+        return std::forward_as_tuple((table.*members)...);
+    }
+};
+
+template <std::size_t... I>
+struct columns_at_fn
+{
+    template <class Table>
+    constexpr auto operator()(Table& table) const
+    {
+        return std::forward_as_tuple(std::get<I>(table)...);
+    }
+};
+
+}  // namespace detail
+
+// Selects columns of a struct-of-arrays table, by member pointer or by position in a tuple-like table, as a tuple
+// of references. Piped into `reduce`, the columns are walked side by side and their items become the arguments of
+// each step, so only the selected columns are read.
+static constexpr inline auto columns = detail::columns_fn{};
+
+template <std::size_t... I>
+static constexpr inline auto columns_at = detail::columns_at_fn<I...>{};
+
+}  // namespace dux
+}  // namespace ferrugo
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+// Lines of a text held in memory, viewed in place without the line terminators.
+// A trailing terminator does not start another, empty line.
+class lines_t
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        constexpr iterator() = default;
+
+        iterator(const char* pos, const char* last) : m_pos{ pos }, m_last{ last }, m_eol{ find_eol(pos, last) }
+        {
+        }
+
+        auto operator*() const -> std::string_view
+        {
+            return std::string_view(m_pos, static_cast<std::size_t>(m_eol - m_pos));
+        }
+
+        auto operator++() -> iterator&
+        {
+            m_pos = m_eol == m_last ? m_last : m_eol + 1;
+            m_eol = find_eol(m_pos, m_last);
+            return *this;
+        }
+
+        auto operator++(int) -> iterator
+        {
+            iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs)
+        {
+            return lhs.m_pos == rhs.m_pos;
+        }
+
+        friend bool operator!=(const iterator& lhs, const iterator& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        static auto find_eol(const char* pos, const char* last) -> const char*
+        {
+            const void* eol = pos != last ? std::memchr(pos, '\n', static_cast<std::size_t>(last - pos)) : nullptr;
+            return eol ? static_cast<const char*>(eol) : last;
+        }
+
+        const char* m_pos = nullptr;
+        const char* m_last = nullptr;
+        const char* m_eol = nullptr;
+    };
+
+    explicit lines_t(std::string_view text) : m_text{ text }
+    {
+    }
+
+    auto begin() const -> iterator
+    {
+        return iterator{ m_text.data(), m_text.data() + m_text.size() };
+    }
+
+    auto end() const -> iterator
+    {
+        return iterator{ m_text.data() + m_text.size(), m_text.data() + m_text.size() };
+    }
+
+private:
+    std::string_view m_text;
+};
+
+// Consecutive fixed-size records of a byte sequence held in memory; an incomplete trailing record is left out.
+// Records of size 0 make an empty range.
+class records_t
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        constexpr iterator() = default;
+
+        constexpr iterator(const char* pos, std::size_t size) : m_pos{ pos }, m_size{ size }
+        {
+        }
+
+        constexpr auto operator*() const -> std::string_view
+        {
+            return std::string_view(m_pos, m_size);
+        }
+
+        constexpr auto operator[](difference_type n) const -> std::string_view
+        {
+            return *(*this + n);
+        }
+
+        constexpr auto operator++() -> iterator&
+        {
+            m_pos += m_size;
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> iterator
+        {
+            iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        constexpr auto operator--() -> iterator&
+        {
+            m_pos -= m_size;
+            return *this;
+        }
+
+        constexpr auto operator--(int) -> iterator
+        {
+            iterator result = *this;
+            --(*this);
+            return result;
+        }
+
+        constexpr auto operator+=(difference_type n) -> iterator&
+        {
+            m_pos += n * static_cast<difference_type>(m_size);
+            return *this;
+        }
+
+        constexpr auto operator-=(difference_type n) -> iterator&
+        {
+            return *this += -n;
+        }
+
+        friend constexpr auto operator+(iterator it, difference_type n) -> iterator
+        {
+            return it += n;
+        }
+
+        friend constexpr auto operator+(difference_type n, iterator it) -> iterator
+        {
+            return it += n;
+        }
+
+        friend constexpr auto operator-(iterator it, difference_type n) -> iterator
+        {
+            return it -= n;
+        }
+
+        // Records of size 0 form an empty range, whose begin and end are the same position.
+        friend constexpr auto operator-(const iterator& lhs, const iterator& rhs) -> difference_type
+        {
+            return lhs.m_size > 0 ? (lhs.m_pos - rhs.m_pos) / static_cast<difference_type>(lhs.m_size) : 0;
+        }
+
+        friend constexpr bool operator==(const iterator& lhs, const iterator& rhs)
+        {
+            return lhs.m_pos == rhs.m_pos;
+        }
+
+        friend constexpr bool operator!=(const iterator& lhs, const iterator& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend constexpr bool operator<(const iterator& lhs, const iterator& rhs)
+        {
+            return lhs.m_pos < rhs.m_pos;
+        }
+
+        friend constexpr bool operator>(const iterator& lhs, const iterator& rhs)
+        {
+            return rhs < lhs;
+        }
+
+        friend constexpr bool operator<=(const iterator& lhs, const iterator& rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+        friend constexpr bool operator>=(const iterator& lhs, const iterator& rhs)
+        {
+            return !(lhs < rhs);
+        }
+
+    private:
+        const char* m_pos = nullptr;
+        std::size_t m_size = 0;
+    };
+
+    constexpr records_t(std::string_view bytes, std::size_t size)
+        : m_data{ bytes.data() }
+        , m_size{ size }
+        , m_count{ size > 0 ? bytes.size() / size : 0 }
+    {
+    }
+
+    constexpr auto begin() const -> iterator
+    {
+        return iterator{ m_data, m_size };
+    }
+
+    constexpr auto end() const -> iterator
+    {
+        return iterator{ m_data + m_count * m_size, m_size };
+    }
+
+    constexpr auto size() const -> std::size_t
+    {
+        return m_count;
+    }
+
+private:
+    const char* m_data;
+    std::size_t m_size;
+    std::size_t m_count;
+};
+
+struct lines_fn
+{
+    auto operator()(std::string_view text) const -> lines_t
+    {
+        return lines_t{ text };
+    }
+};
+
+struct records_fn
+{
+    constexpr auto operator()(std::string_view bytes, std::size_t size) const -> records_t
+    {
+        return records_t{ bytes, size };
+    }
+};
+
+}  // namespace detail
+
+static constexpr inline auto lines = detail::lines_fn{};
+static constexpr inline auto records = detail::records_fn{};
+
+}  // namespace dux
+}  // namespace ferrugo
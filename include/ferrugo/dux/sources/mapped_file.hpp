@@ -0,0 +1,124 @@
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+// Read-only memory mapping of a whole file, exposed as a contiguous range of bytes so that `lines` or `records`
+// can walk it in place. Pages are brought in by the kernel as the reduction reaches them.
+class mapped_file
+{
+public:
+    using value_type = char;
+    using iterator = const char*;
+
+    explicit mapped_file(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::system_error{ errno, std::generic_category(), path };
+        }
+        try
+        {
+            map(fd, path);
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+    }
+
+    mapped_file(mapped_file&& other) noexcept
+        : m_data{ std::exchange(other.m_data, nullptr) }
+        , m_size{ std::exchange(other.m_size, 0) }
+    {
+    }
+
+    mapped_file& operator=(mapped_file other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        return *this;
+    }
+
+    ~mapped_file()
+    {
+        if (m_data)
+        {
+            ::munmap(m_data, m_size);
+        }
+    }
+
+    auto data() const -> const char*
+    {
+        return static_cast<const char*>(m_data);
+    }
+
+    auto size() const -> std::size_t
+    {
+        return m_size;
+    }
+
+    auto begin() const -> iterator
+    {
+        return data();
+    }
+
+    auto end() const -> iterator
+    {
+        return data() + m_size;
+    }
+
+    operator std::string_view() const
+    {
+        return std::string_view(data(), m_size);
+    }
+
+private:
+    void map(int fd, const std::string& path)
+    {
+        struct stat info;
+        if (::fstat(fd, &info) != 0)
+        {
+            throw std::system_error{ errno, std::generic_category(), path };
+        }
+        m_size = static_cast<std::size_t>(info.st_size);
+        if (m_size == 0)
+        {
+            return;
+        }
+        void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            throw std::system_error{ errno, std::generic_category(), path };
+        }
+        ::madvise(data, m_size, MADV_SEQUENTIAL);
+        m_data = data;
+    }
+
+    void* m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+}  // namespace dux
+}  // namespace ferrugo
+
+#endif
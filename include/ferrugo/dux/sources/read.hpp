@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <system_error>
+
+#include <unistd.h>
+#endif
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+struct istream_reader_t
+{
+    std::istream* m_stream;
+
+    auto operator()(char* data, std::size_t size) const -> std::size_t
+    {
+        m_stream->read(data, static_cast<std::streamsize>(size));
+        return static_cast<std::size_t>(m_stream->gcount());
+    }
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+struct fd_reader_t
+{
+    int m_fd;
+
+    auto operator()(char* data, std::size_t size) const -> std::size_t
+    {
+        while (true)
+        {
+            const ::ssize_t result = ::read(m_fd, data, size);
+            if (result >= 0)
+            {
+                return static_cast<std::size_t>(result);
+            }
+            if (errno != EINTR)
+            {
+                throw std::system_error{ errno, std::generic_category(), "read" };
+            }
+        }
+    }
+};
+#endif
+
+// Reads the input in large blocks into a single buffer and hands out views into it. The buffer only grows when
+// a line does not fit in it, so memory use stays bounded by the block size and the longest line.
+template <class Reader>
+class block_buffer_t
+{
+public:
+    block_buffer_t(Reader reader, std::size_t block_size)
+        : m_reader{ std::move(reader) }
+        , m_buffer(std::max(block_size, std::size_t{ 1 }))
+    {
+    }
+
+    auto next_line() -> std::optional<std::string_view>
+    {
+        while (true)
+        {
+            const char* first = m_buffer.data() + m_begin;
+            const std::size_t size = m_end - m_begin;
+            if (const void* eol = size > 0 ? std::memchr(first, '\n', size) : nullptr)
+            {
+                const auto length = static_cast<std::size_t>(static_cast<const char*>(eol) - first);
+                m_begin += length + 1;
+                return std::string_view(first, length);
+            }
+            if (m_eof)
+            {
+                if (size == 0)
+                {
+                    return std::nullopt;
+                }
+                m_begin = m_end;
+                return std::string_view(first, size);
+            }
+            fill();
+        }
+    }
+
+    auto next_block() -> std::optional<std::string_view>
+    {
+        if (m_begin == m_end)
+        {
+            m_begin = m_end = 0;
+            fill();
+        }
+        if (m_begin == m_end)
+        {
+            return std::nullopt;
+        }
+        const std::string_view result(m_buffer.data() + m_begin, m_end - m_begin);
+        m_begin = m_end;
+        return result;
+    }
+
+private:
+    void fill()
+    {
+        if (m_eof)
+        {
+            return;
+        }
+        if (m_begin > 0)
+        {
+            std::copy(m_buffer.begin() + m_begin, m_buffer.begin() + m_end, m_buffer.begin());
+            m_end -= m_begin;
+            m_begin = 0;
+        }
+        if (m_end == m_buffer.size())
+        {
+            m_buffer.resize(2 * m_buffer.size());
+        }
+        const std::size_t count = m_reader(m_buffer.data() + m_end, m_buffer.size() - m_end);
+        m_eof = count == 0;
+        m_end += count;
+    }
+
+    Reader m_reader;
+    std::vector<char> m_buffer;
+    std::size_t m_begin = 0;
+    std::size_t m_end = 0;
+    bool m_eof = false;
+};
+
+// Single pass range over the lines or blocks of a stream. Every item is a view into the read buffer and stays
+// valid only until the next one is read, so a stage that keeps items around must copy them.
+template <class Reader, bool Lines>
+class read_range_t
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        iterator() = default;
+
+        explicit iterator(block_buffer_t<Reader>* buffer) : m_buffer{ buffer }
+        {
+            ++(*this);
+        }
+
+        auto operator*() const -> std::string_view
+        {
+            return m_current;
+        }
+
+        auto operator++() -> iterator&
+        {
+            const std::optional<std::string_view> next = Lines ? m_buffer->next_line() : m_buffer->next_block();
+            if (next)
+            {
+                m_current = *next;
+            }
+            else
+            {
+                m_buffer = nullptr;
+            }
+            return *this;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs)
+        {
+            return lhs.m_buffer == rhs.m_buffer;
+        }
+
+        friend bool operator!=(const iterator& lhs, const iterator& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        block_buffer_t<Reader>* m_buffer = nullptr;
+        std::string_view m_current;
+    };
+
+    read_range_t(Reader reader, std::size_t block_size)
+        : m_buffer{ std::make_unique<block_buffer_t<Reader>>(std::move(reader), block_size) }
+    {
+    }
+
+    auto begin() const -> iterator
+    {
+        return iterator{ m_buffer.get() };
+    }
+
+    auto end() const -> iterator
+    {
+        return iterator{};
+    }
+
+private:
+    std::unique_ptr<block_buffer_t<Reader>> m_buffer;
+};
+
+static constexpr inline std::size_t default_block_size = std::size_t{ 1 } << 16;
+
+template <bool Lines>
+struct read_fn
+{
+    auto operator()(std::istream& stream, std::size_t block_size = default_block_size) const
+        -> read_range_t<istream_reader_t, Lines>
+    {
+        return { istream_reader_t{ &stream }, block_size };
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    auto operator()(int fd, std::size_t block_size = default_block_size) const -> read_range_t<fd_reader_t, Lines>
+    {
+        return { fd_reader_t{ fd }, block_size };
+    }
+#endif
+};
+
+}  // namespace detail
+
+static constexpr inline auto read_lines = detail::read_fn<true>{};
+static constexpr inline auto read_blocks = detail::read_fn<false>{};
+
+}  // namespace dux
+}  // namespace ferrugo
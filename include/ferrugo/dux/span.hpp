@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+// Non-owning view over a contiguous sequence, used by the stages that emit or consume blocks of items.
+template <class T>
+struct span_t
+{
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    T* m_data = nullptr;
+    std::size_t m_size = 0;
+
+    constexpr span_t() = default;
+
+    constexpr span_t(T* data, std::size_t size) : m_data{ data }, m_size{ size }
+    {
+    }
+
+    template <class U, std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>, int> = 0>
+    constexpr span_t(span_t<U> other) : m_data{ other.data() }, m_size{ other.size() }
+    {
+    }
+
+    constexpr auto data() const -> T*
+    {
+        return m_data;
+    }
+
+    constexpr auto size() const -> std::size_t
+    {
+        return m_size;
+    }
+
+    constexpr bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    constexpr auto begin() const -> iterator
+    {
+        return m_data;
+    }
+
+    constexpr auto end() const -> iterator
+    {
+        return m_data + m_size;
+    }
+
+    constexpr auto operator[](std::size_t index) const -> T&
+    {
+        return m_data[index];
+    }
+
+    constexpr auto subspan(std::size_t offset, std::size_t count) const -> span_t
+    {
+        return span_t{ m_data + offset, count };
+    }
+};
+
+}  // namespace dux
+}  // namespace ferrugo
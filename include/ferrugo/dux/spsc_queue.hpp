@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ferrugo
+{
+namespace dux
+{
+namespace detail
+{
+
+// Waits by yielding first and sleeping once the wait gets long, so that an idle side does not hold on to a core.
+struct backoff_t
+{
+    unsigned m_count = 0;
+
+    void operator()()
+    {
+        if (++m_count < 64)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds{ 50 });
+        }
+    }
+};
+
+// Bounded lock-free queue between exactly one producer and one consumer thread. Each side caches the other's index
+// and only reloads it when the queue looks full or empty, so the shared cache lines are touched rarely.
+template <class T>
+class spsc_queue_t
+{
+public:
+    explicit spsc_queue_t(std::size_t capacity) : m_slots(round_up(capacity)), m_mask{ m_slots.size() - 1 }
+    {
+    }
+
+    spsc_queue_t(const spsc_queue_t&) = delete;
+    spsc_queue_t& operator=(const spsc_queue_t&) = delete;
+
+    auto capacity() const -> std::size_t
+    {
+        return m_slots.size();
+    }
+
+    bool try_push(T& item)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head_cache == m_slots.size())
+        {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            if (tail - m_head_cache == m_slots.size())
+            {
+                return false;
+            }
+        }
+        m_slots[tail & m_mask] = std::move(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& item)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail_cache)
+        {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tail_cache)
+            {
+                return false;
+            }
+        }
+        item = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Blocks the producer while the queue is full, which is what keeps a fast producer from running ahead.
+    void push(T item)
+    {
+        for (backoff_t backoff; !try_push(item);)
+        {
+            backoff();
+        }
+    }
+
+    auto pop() -> T
+    {
+        T item;
+        for (backoff_t backoff; !try_pop(item);)
+        {
+            backoff();
+        }
+        return item;
+    }
+
+private:
+    static constexpr std::size_t cache_line_size = 64;
+
+    static auto round_up(std::size_t capacity) -> std::size_t
+    {
+        std::size_t result = 2;
+        while (result < capacity)
+        {
+            result *= 2;
+        }
+        return result;
+    }
+
+    std::vector<T> m_slots;
+    std::size_t m_mask;
+    alignas(cache_line_size) std::atomic<std::size_t> m_head{ 0 };
+    std::size_t m_tail_cache = 0;
+    alignas(cache_line_size) std::atomic<std::size_t> m_tail{ 0 };
+    std::size_t m_head_cache = 0;
+};
+
+}  // namespace detail
+}  // namespace dux
+}  // namespace ferrugo
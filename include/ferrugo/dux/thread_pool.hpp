@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+// Work-stealing thread pool: every worker owns a task deque, pops its own tasks LIFO
+// and steals FIFO from the other workers once its own deque runs dry.
+class thread_pool
+{
+public:
+    explicit thread_pool(std::size_t thread_count = std::thread::hardware_concurrency())
+    {
+        thread_count = std::max(thread_count, std::size_t{ 1 });
+        m_queues.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i)
+        {
+            m_queues.push_back(std::make_unique<queue_t>());
+        }
+        m_threads.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i)
+        {
+            m_threads.emplace_back([this, i] { run(i); });
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        for (std::thread& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    auto size() const -> std::size_t
+    {
+        return m_threads.size();
+    }
+
+    template <class Func>
+    auto submit(Func&& func) -> std::future<std::invoke_result_t<std::decay_t<Func>>>
+    {
+        using result_type = std::invoke_result_t<std::decay_t<Func>>;
+        auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<Func>(func));
+        std::future<result_type> result = task->get_future();
+        push([task]() { (*task)(); });
+        return result;
+    }
+
+    // Waits for the future, executing pending tasks in the meantime so that a task may wait for the tasks it has
+    // submitted without starving the pool.
+    template <class T>
+    auto wait(std::future<T>& future) -> T
+    {
+        while (future.wait_for(std::chrono::seconds{ 0 }) != std::future_status::ready)
+        {
+            std::function<void()> task;
+            if (try_pop(current_index(), task))
+            {
+                task();
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        return future.get();
+    }
+
+    static auto instance() -> thread_pool&
+    {
+        static thread_pool pool{};
+        return pool;
+    }
+
+private:
+    struct queue_t
+    {
+        std::mutex m_mutex;
+        std::deque<std::function<void()>> m_tasks;
+    };
+
+    static auto worker() -> std::pair<const thread_pool*, std::size_t>&
+    {
+        static thread_local std::pair<const thread_pool*, std::size_t> result{ nullptr, 0 };
+        return result;
+    }
+
+    auto current_index() const -> std::size_t
+    {
+        const auto& [pool, index] = worker();
+        return pool == this ? index : m_next.load(std::memory_order_relaxed) % m_queues.size();
+    }
+
+    void push(std::function<void()> task)
+    {
+        const auto& [pool, index] = worker();
+        queue_t& queue
+            = *m_queues[pool == this ? index : m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size()];
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            ++m_pending;
+        }
+        {
+            std::lock_guard<std::mutex> lock{ queue.m_mutex };
+            queue.m_tasks.push_back(std::move(task));
+        }
+        m_condition.notify_one();
+    }
+
+    bool try_pop(std::size_t index, std::function<void()>& task)
+    {
+        for (std::size_t i = 0; i < m_queues.size(); ++i)
+        {
+            queue_t& queue = *m_queues[(index + i) % m_queues.size()];
+            std::lock_guard<std::mutex> lock{ queue.m_mutex };
+            if (queue.m_tasks.empty())
+            {
+                continue;
+            }
+            if (i == 0)
+            {
+                task = std::move(queue.m_tasks.back());
+                queue.m_tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.m_tasks.front());
+                queue.m_tasks.pop_front();
+            }
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void run(std::size_t index)
+    {
+        worker() = { this, index };
+        while (true)
+        {
+            std::function<void()> task;
+            if (try_pop(index, task))
+            {
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_condition.wait(lock, [&] { return m_stop || m_pending.load(std::memory_order_relaxed) > 0; });
+            if (m_stop && m_pending.load(std::memory_order_relaxed) == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<queue_t>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<std::size_t> m_next{ 0 };
+    std::atomic<std::size_t> m_pending{ 0 };
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stop = false;
+};
+
+}  // namespace dux
+}  // namespace ferrugo
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <exception>
+#include <ferrugo/dux/interfaces.hpp>
+#include <ferrugo/dux/worker.hpp>
+#include <memory>
+#include <type_traits>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+namespace detail
+{
+
+template <class T>
+struct async_stage_fn
+{
+    template <class Reducer>
+    struct reducer_t
+    {
+        Reducer m_next_reducer;
+        batch_options m_options;
+
+        struct run_t
+        {
+            const reducer_t* m_reducer;
+            run_context m_context;
+            batch_sender_t<T> m_sender;
+
+            template <class State, class... Args>
+            void operator()(State& state, Args&&... args)
+            {
+                worker<State>(state);
+                m_sender.add(std::forward<Args>(args)...);
+            }
+
+            bool done() const
+            {
+                return m_sender.m_done;
+            }
+
+            template <class State>
+            void complete(State& state)
+            {
+                auto& w = worker<State>(state);
+                m_sender.flush();
+                w.join();
+                if (const std::exception_ptr error = w.error())
+                {
+                    std::rethrow_exception(error);
+                }
+                state = w.take_state();
+                m_sender.m_worker.reset();
+            }
+
+        private:
+            template <class State>
+            using worker_type = batch_worker_t<T, Reducer, State>;
+
+            // The downstream thread is started on the first item and takes over the state until completion.
+            template <class State>
+            auto worker(State& state) -> worker_type<State>&
+            {
+                if (!m_sender.m_worker)
+                {
+                    m_sender.m_worker = std::make_unique<worker_type<State>>(
+                        m_reducer->m_next_reducer, std::move(state), m_reducer->m_options.queue_size, m_context);
+                }
+                return static_cast<worker_type<State>&>(*m_sender.m_worker);
+            }
+        };
+
+        auto start(const run_context& context = {}) const -> run_t
+        {
+            return run_t{ this, context, batch_sender_t<T>{ m_options } };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count);
+        }
+    };
+
+    struct transducer_t
+    {
+        batch_options m_options;
+
+        template <class Reducer>
+        constexpr auto operator()(Reducer&& next_reducer) const -> reducer_interface_t<reducer_t<std::decay_t<Reducer>>>
+        {
+            return { { std::forward<Reducer>(next_reducer), m_options } };
+        }
+    };
+
+    constexpr auto operator()(batch_options options = {}) const -> transducer_interface_t<transducer_t>
+    {
+        return { { normalize(options) } };
+    }
+};
+
+}  // namespace detail
+
+// Stage boundary: the stages before it run on the calling thread and the rest of the chain on a worker thread of
+// its own. Items, copied as `T`, cross over in batches through a bounded queue that stalls the producer when full.
+// The downstream side takes over the state on the first item and hands it back on completion, rethrowing anything
+// it has thrown.
+template <class T>
+static constexpr inline auto async_stage = detail::async_stage_fn<T>{};
+
+}  // namespace dux
+}  // namespace ferrugo
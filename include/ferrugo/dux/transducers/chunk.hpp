@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <ferrugo/dux/interfaces.hpp>
+#include <ferrugo/dux/span.hpp>
+#include <memory_resource>
+#include <vector>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+namespace detail
+{
+
+template <class T>
+struct chunk_fn
+{
+    template <class Reducer>
+    struct reducer_t
+    {
+        Reducer m_next_reducer;
+        std::size_t m_size;
+
+        struct run_t
+        {
+            start_result_t<Reducer> m_next;
+            std::size_t m_size;
+            std::pmr::vector<T> m_buffer;
+
+            template <class State, class... Args>
+            void operator()(State& state, Args&&... args)
+            {
+                m_buffer.emplace_back(std::forward<Args>(args)...);
+                if (m_buffer.size() == m_size)
+                {
+                    flush(state);
+                }
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            void complete(State& state)
+            {
+                if (!m_buffer.empty() && !is_done(m_next))
+                {
+                    flush(state);
+                }
+                detail::complete(m_next, state);
+            }
+
+        private:
+            template <class State>
+            void flush(State& state)
+            {
+                step(m_next, state, span_t<const T>{ m_buffer.data(), m_buffer.size() });
+                m_buffer.clear();
+            }
+        };
+
+        auto start(const run_context& context = {}) const -> run_t
+        {
+            std::pmr::vector<T> buffer{ context.resource };
+            buffer.reserve(m_size);
+            return { detail::start(m_next_reducer, context), m_size, std::move(buffer) };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, (count + m_size - 1) / m_size);
+        }
+    };
+
+    struct transducer_t
+    {
+        std::size_t m_size;
+
+        template <class Reducer>
+        constexpr auto operator()(Reducer&& next_reducer) const -> reducer_interface_t<reducer_t<std::decay_t<Reducer>>>
+        {
+            return { { std::forward<Reducer>(next_reducer), m_size } };
+        }
+    };
+    constexpr auto operator()(std::ptrdiff_t size) const -> transducer_interface_t<transducer_t>
+    {
+        return { { static_cast<std::size_t>(std::max(size, std::ptrdiff_t{ 1 })) } };
+    }
+};
+
+}  // namespace detail
+
+// Groups consecutive items into chunks of `size` and passes each chunk downstream as a `span_t<const T>`
+// over a buffer that is taken once per run from the resource of the run context and reused; the trailing partial
+// chunk is emitted on completion.
+// The span is only valid for the duration of the downstream call.
+template <class T>
+static constexpr inline auto chunk = detail::chunk_fn<T>{};
+
+}  // namespace dux
+}  // namespace ferrugo
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <ferrugo/dux/bloom_filter.hpp>
+#include <ferrugo/dux/flat_table.hpp>
+#include <ferrugo/dux/identity.hpp>
+#include <ferrugo/dux/interfaces.hpp>
+#include <functional>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+namespace detail
+{
+
+template <class Key, class Hash, class KeyEqual>
+bool insert_key(flat_set<Key, Hash, KeyEqual>& seen, Key key)
+{
+    return seen.insert(std::move(key)).second;
+}
+
+template <class Key, class Hash>
+bool insert_key(bloom_filter<Key, Hash>& seen, const Key& key)
+{
+    return seen.insert(key);
+}
+
+// Builders of the keys seen by a run, which allocate them from the resource of the run context.
+template <class Key>
+struct make_flat_set_t
+{
+    auto operator()(std::pmr::memory_resource* resource) const -> flat_set<Key>
+    {
+        return flat_set<Key>{ 0, resource };
+    }
+};
+
+template <class Key>
+struct make_bloom_filter_t
+{
+    bloom_options m_options;
+
+    auto operator()(std::pmr::memory_resource* resource) const -> bloom_filter<Key>
+    {
+        return bloom_filter<Key>{ m_options, {}, resource };
+    }
+};
+
+template <class Key>
+struct distinct_fn
+{
+    template <class Reducer, class KeyFn, class MakeSeen>
+    struct reducer_t
+    {
+        using seen_type = std::invoke_result_t<const MakeSeen&, std::pmr::memory_resource*>;
+
+        Reducer m_next_reducer;
+        KeyFn m_key_fn;
+        MakeSeen m_make_seen;
+
+        struct run_t
+        {
+            start_result_t<Reducer> m_next;
+            const KeyFn& m_key_fn;
+            seen_type m_seen;
+
+            template <class State, class... Args>
+            void operator()(State& state, Args&&... args)
+            {
+                if (insert_key(m_seen, Key(std::invoke(m_key_fn, std::as_const(args)...))))
+                {
+                    step(m_next, state, std::forward<Args>(args)...);
+                }
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+        };
+
+        auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_key_fn, m_make_seen(context.resource) };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count);
+        }
+    };
+
+    template <class KeyFn, class MakeSeen>
+    struct transducer_t
+    {
+        KeyFn m_key_fn;
+        MakeSeen m_make_seen;
+
+        template <class Reducer>
+        constexpr auto operator()(Reducer&& next_reducer) const
+            -> reducer_interface_t<reducer_t<std::decay_t<Reducer>, KeyFn, MakeSeen>>
+        {
+            return { { std::forward<Reducer>(next_reducer), m_key_fn, m_make_seen } };
+        }
+    };
+
+    template <class KeyFn = identity_fn>
+    constexpr auto operator()(KeyFn&& key_fn = {}) const
+        -> transducer_interface_t<transducer_t<std::decay_t<KeyFn>, make_flat_set_t<Key>>>
+    {
+        return { { std::forward<KeyFn>(key_fn), make_flat_set_t<Key>{} } };
+    }
+
+    template <class KeyFn = identity_fn>
+    constexpr auto operator()(bloom_options options, KeyFn&& key_fn = {}) const
+        -> transducer_interface_t<transducer_t<std::decay_t<KeyFn>, make_bloom_filter_t<Key>>>
+    {
+        return { { std::forward<KeyFn>(key_fn), make_bloom_filter_t<Key>{ options } } };
+    }
+};
+
+}  // namespace detail
+
+// Passes on the first item of every key, the key being `key_fn(item)` (the item itself by default) converted to
+// `Key`. The keys seen so far are kept in a `flat_set`, or, given `bloom_options`, in a `bloom_filter` of fixed size
+// which may mistake a new key for a seen one at the configured rate and drop its item. Either is built afresh by every
+// run, from the memory resource of its context.
+template <class Key>
+static constexpr inline auto distinct = detail::distinct_fn<Key>{};
+
+}  // namespace dux
+}  // namespace ferrugo
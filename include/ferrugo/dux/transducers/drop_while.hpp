@@ -16,13 +16,49 @@ struct drop_while_fn
     {
         Reducer m_next_reducer;
         Pred m_pred;
-        mutable bool m_done = false;
 
-        template <class State, class... Args>
-        constexpr auto operator()(State state, Args&&... args) const -> State
+        struct run_t
         {
-            m_done = m_done || !std::invoke(m_pred, args...);
-            return m_done ? m_next_reducer(std::move(state), std::forward<Args>(args)...) : state;
+            start_result_t<Reducer> m_next;
+            const Pred& m_pred;
+            bool m_done = false;
+
+            template <class State, class... Args>
+            constexpr void operator()(State& state, Args&&... args)
+            {
+                m_done = m_done || !std::invoke(m_pred, args...);
+                if (m_done)
+                {
+                    step(m_next, state, std::forward<Args>(args)...);
+                }
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            constexpr void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_pred };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count);
         }
     };
 
@@ -20,14 +20,48 @@ struct filter_fn
         Reducer m_next_reducer;
         Pred m_pred;
 
-        template <class State, class... Args>
-        constexpr auto operator()(State state, Args&&... args) const -> State
+        struct run_t
         {
-            if (std::invoke(m_pred, args...))
+            static constexpr bool stateless = is_stateless_run<start_result_t<Reducer>>::value;
+
+            start_result_t<Reducer> m_next;
+            const Pred& m_pred;
+
+            template <class State, class... Args>
+            constexpr void operator()(State& state, Args&&... args)
+            {
+                if (std::invoke(m_pred, args...))
+                {
+                    step(m_next, state, std::forward<Args>(args)...);
+                }
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            constexpr void complete(State& state)
             {
-                return m_next_reducer(std::move(state), std::forward<Args>(args)...);
+                detail::complete(m_next, state);
             }
-            return state;
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_pred };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count);
         }
     };
 
@@ -36,16 +70,48 @@ struct filter_fn
     {
         Reducer m_next_reducer;
         Pred m_pred;
-        mutable std::ptrdiff_t m_index = 0;
 
-        template <class State, class... Args>
-        constexpr auto operator()(State state, Args&&... args) const -> State
+        struct run_t
         {
-            if (std::invoke(m_pred, m_index++, args...))
+            start_result_t<Reducer> m_next;
+            const Pred& m_pred;
+            std::ptrdiff_t m_index = 0;
+
+            template <class State, class... Args>
+            constexpr void operator()(State& state, Args&&... args)
+            {
+                if (std::invoke(m_pred, m_index++, args...))
+                {
+                    step(m_next, state, std::forward<Args>(args)...);
+                }
+            }
+
+            constexpr bool done() const
             {
-                return m_next_reducer(std::move(state), std::forward<Args>(args)...);
+                return is_done(m_next);
             }
-            return state;
+
+            template <class State>
+            constexpr void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_pred };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count);
         }
     };
 
@@ -21,11 +21,46 @@ struct inspect_fn
         Reducer m_next_reducer;
         Func m_func;
 
-        template <class State, class... Args>
-        constexpr auto operator()(State state, Args&&... args) const -> State
+        struct run_t
         {
-            std::invoke(m_func, args...);
-            return m_next_reducer(std::move(state), std::forward<Args>(args)...);
+            static constexpr bool stateless = is_stateless_run<start_result_t<Reducer>>::value;
+
+            start_result_t<Reducer> m_next;
+            const Func& m_func;
+
+            template <class State, class... Args>
+            constexpr void operator()(State& state, Args&&... args)
+            {
+                std::invoke(m_func, args...);
+                step(m_next, state, std::forward<Args>(args)...);
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            constexpr void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_func };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count);
         }
     };
 
@@ -34,13 +69,46 @@ struct inspect_fn
     {
         Reducer m_next_reducer;
         Func m_func;
-        mutable std::ptrdiff_t m_index = 0;
 
-        template <class State, class... Args>
-        constexpr auto operator()(State state, Args&&... args) const -> State
+        struct run_t
+        {
+            start_result_t<Reducer> m_next;
+            const Func& m_func;
+            std::ptrdiff_t m_index = 0;
+
+            template <class State, class... Args>
+            constexpr void operator()(State& state, Args&&... args)
+            {
+                std::invoke(m_func, m_index++, args...);
+                step(m_next, state, std::forward<Args>(args)...);
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            constexpr void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_func };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
         {
-            std::invoke(m_func, m_index++, args...);
-            return m_next_reducer(std::move(state), std::forward<Args>(args)...);
+            return detail::size_hint(m_next_reducer, count);
         }
     };
 
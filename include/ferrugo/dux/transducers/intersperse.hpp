@@ -18,17 +18,54 @@ struct intersperse_fn
     {
         Reducer m_next_reducer;
         Delimiter m_delimiter;
-        mutable bool m_init = false;
 
-        template <class State, class... Args>
-        constexpr auto operator()(State state, Args&&... args) const -> State
+        struct run_t
         {
-            if (m_init)
+            start_result_t<Reducer> m_next;
+            const Delimiter& m_delimiter;
+            bool m_init = false;
+
+            template <class State, class... Args>
+            constexpr void operator()(State& state, Args&&... args)
+            {
+                if (m_init)
+                {
+                    step(m_next, state, m_delimiter);
+                    if (is_done(m_next))
+                    {
+                        return;
+                    }
+                }
+                m_init = true;
+                step(m_next, state, std::forward<Args>(args)...);
+            }
+
+            constexpr bool done() const
             {
-                state = m_next_reducer(std::move(state), m_delimiter);
+                return is_done(m_next);
             }
-            m_init = true;
-            return m_next_reducer(std::move(state), std::forward<Args>(args)...);
+
+            template <class State>
+            constexpr void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_delimiter };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count > 0 ? 2 * count - 1 : 0);
         }
     };
 
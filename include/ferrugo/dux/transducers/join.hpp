@@ -9,16 +9,15 @@ namespace dux
 namespace detail
 {
 
-template <class Range, class State, class BinaryOp>
-constexpr auto accumulate(Range&& range, State state, BinaryOp&& op) -> State
+template <class Range, class State, class Reducer>
+constexpr void accumulate(Range&& range, State& state, Reducer& reducer)
 {
     auto begin = std::begin(range);
     const auto end = std::end(range);
-    for (; begin != end; ++begin)
+    for (; begin != end && !is_done(reducer); ++begin)
     {
-        state = std::invoke(op, std::move(state), *begin);
+        step(reducer, state, *begin);
     }
-    return state;
 }
 
 struct join_with_fn
@@ -28,17 +27,54 @@ struct join_with_fn
     {
         Reducer m_next_reducer;
         Delimiter m_delimiter;
-        mutable bool m_first_item = true;
 
-        template <class State, class Arg>
-        constexpr auto operator()(State state, Arg&& arg) const -> State
+        struct run_t
         {
-            if (!m_first_item)
+            start_result_t<Reducer> m_next;
+            const Delimiter& m_delimiter;
+            bool m_first_item = true;
+
+            template <class State, class Arg>
+            constexpr void operator()(State& state, Arg&& arg)
             {
-                state = accumulate(m_delimiter, std::move(state), m_next_reducer);
+                if (!m_first_item)
+                {
+                    detail::accumulate(m_delimiter, state, m_next);
+                    if (is_done(m_next))
+                    {
+                        return;
+                    }
+                }
+                m_first_item = false;
+                detail::accumulate(arg, state, m_next);
             }
-            m_first_item = false;
-            return accumulate(arg, std::move(state), m_next_reducer);
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            constexpr void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_delimiter };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t) const -> std::optional<std::size_t>
+        {
+            return std::nullopt;
         }
     };
 
@@ -69,10 +105,44 @@ struct join_fn
     {
         Reducer m_next_reducer;
 
-        template <class State, class Arg>
-        constexpr auto operator()(State state, Arg&& arg) const -> State
+        struct run_t
+        {
+            static constexpr bool stateless = is_stateless_run<start_result_t<Reducer>>::value;
+
+            start_result_t<Reducer> m_next;
+
+            template <class State, class Arg>
+            constexpr void operator()(State& state, Arg&& arg)
+            {
+                detail::accumulate(arg, state, m_next);
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            constexpr void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context) };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t) const -> std::optional<std::size_t>
         {
-            return accumulate(arg, std::move(state), m_next_reducer);
+            return std::nullopt;
         }
     };
 
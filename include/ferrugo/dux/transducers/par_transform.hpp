@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <ferrugo/dux/interfaces.hpp>
+#include <ferrugo/dux/thread_pool.hpp>
+#include <future>
+#include <type_traits>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+namespace detail
+{
+
+template <class T>
+struct par_transform_fn
+{
+    template <class Reducer, class Func>
+    struct reducer_t
+    {
+        using result_type = std::decay_t<std::invoke_result_t<const Func&, T>>;
+
+        Reducer m_next_reducer;
+        Func m_func;
+        thread_pool* m_pool;
+        std::size_t m_window;
+
+        struct run_t
+        {
+            start_result_t<Reducer> m_next;
+            const reducer_t* m_reducer;
+            std::deque<std::future<result_type>> m_pending = {};
+
+            run_t(start_result_t<Reducer> next, const reducer_t* reducer) : m_next{ std::move(next) }, m_reducer{ reducer }
+            {
+            }
+
+            run_t(run_t&&) = default;
+
+            // The tasks refer to the function held by the reducer, so none of them may outlive the run.
+            ~run_t()
+            {
+                for (std::future<result_type>& future : m_pending)
+                {
+                    try
+                    {
+                        m_reducer->m_pool->wait(future);
+                    }
+                    catch (...)
+                    {
+                    }
+                }
+            }
+
+            template <class State, class... Args>
+            void operator()(State& state, Args&&... args)
+            {
+                m_pending.push_back(m_reducer->m_pool->submit(
+                    [func = &m_reducer->m_func, item = T(std::forward<Args>(args)...)]() mutable
+                    { return std::invoke(*func, std::move(item)); }));
+                if (m_pending.size() >= m_reducer->m_window)
+                {
+                    emit(state);
+                }
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            void complete(State& state)
+            {
+                while (!m_pending.empty() && !is_done(m_next))
+                {
+                    emit(state);
+                }
+                detail::complete(m_next, state);
+            }
+
+        private:
+            // Results leave in submission order: the oldest one is awaited even if later ones are ready.
+            template <class State>
+            void emit(State& state)
+            {
+                std::future<result_type> future = std::move(m_pending.front());
+                m_pending.pop_front();
+                step(m_next, state, m_reducer->m_pool->wait(future));
+            }
+        };
+
+        auto start(const run_context& context = {}) const -> run_t
+        {
+            return run_t{ detail::start(m_next_reducer, context), this };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count);
+        }
+    };
+
+    template <class Func>
+    struct transducer_t
+    {
+        Func m_func;
+        thread_pool* m_pool;
+        std::size_t m_window;
+
+        template <class Reducer>
+        constexpr auto operator()(Reducer&& next_reducer) const
+            -> reducer_interface_t<reducer_t<std::decay_t<Reducer>, Func>>
+        {
+            return { { std::forward<Reducer>(next_reducer), m_func, m_pool, m_window } };
+        }
+    };
+
+    template <class Func>
+    auto operator()(thread_pool& pool, Func&& func, std::size_t window = 0) const
+        -> transducer_interface_t<transducer_t<std::decay_t<Func>>>
+    {
+        return { { std::forward<Func>(func), &pool, window > 0 ? window : 4 * pool.size() } };
+    }
+
+    template <class Func>
+    auto operator()(Func&& func, std::size_t window = 0) const -> transducer_interface_t<transducer_t<std::decay_t<Func>>>
+    {
+        return (*this)(thread_pool::instance(), std::forward<Func>(func), window);
+    }
+};
+
+}  // namespace detail
+
+// Applies `func` to items, copied as `T`, on the thread pool while keeping at most `window` of them in flight
+// (four per thread by default), and passes the results downstream in input order.
+template <class T>
+static constexpr inline auto par_transform = detail::par_transform_fn<T>{};
+
+}  // namespace dux
+}  // namespace ferrugo
@@ -0,0 +1,583 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <exception>
+#include <ferrugo/dux/interfaces.hpp>
+#include <ferrugo/dux/thread_pool.hpp>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <stdio.h>
+#include <sys/types.h>
+#endif
+
+namespace ferrugo
+{
+namespace dux
+{
+
+struct sort_options
+{
+    // Bytes of items held in memory at once; whatever does not fit is spilled to temporary files in sorted runs.
+    std::size_t memory_budget = std::size_t{ 64 } << 20;
+    // Sorts the runs in memory on the pool when given.
+    thread_pool* pool = nullptr;
+};
+
+namespace detail
+{
+
+struct file_closer_t
+{
+    void operator()(std::FILE* file) const
+    {
+        std::fclose(file);
+    }
+};
+
+using file_ptr_t = std::unique_ptr<std::FILE, file_closer_t>;
+
+// Runs `func(i)` for every `i` below `count`, the first on the calling thread and the others on the pool, and waits
+// for all of them before rethrowing the first exception.
+template <class Func>
+void for_each_task(thread_pool& pool, std::size_t count, const Func& func)
+{
+    std::vector<std::future<void>> futures;
+    futures.reserve(count);
+    for (std::size_t index = 1; index < count; ++index)
+    {
+        futures.push_back(pool.submit([&func, index]() { func(index); }));
+    }
+    std::exception_ptr error;
+    try
+    {
+        func(0);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    for (std::future<void>& future : futures)
+    {
+        try
+        {
+            pool.wait(future);
+        }
+        catch (...)
+        {
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+// Merges the sorted ranges [first, middle) and [middle, last), moving the shorter of them out to `buffer` first.
+template <class T, class Compare>
+void merge_items(T* first, T* middle, T* last, T* buffer, const Compare& compare)
+{
+    if (middle - first <= last - middle)
+    {
+        T* const buffer_end = std::move(first, middle, buffer);
+        T* left = buffer;
+        T* right = middle;
+        T* out = first;
+        while (left != buffer_end && right != last)
+        {
+            *out++ = compare(*right, *left) ? std::move(*right++) : std::move(*left++);
+        }
+        std::move(left, buffer_end, out);
+    }
+    else
+    {
+        T* const buffer_end = std::move(middle, last, buffer);
+        T* left = middle;
+        T* right = buffer_end;
+        T* out = last;
+        while (left != first && right != buffer)
+        {
+            *--out = compare(*(right - 1), *(left - 1)) ? std::move(*--left) : std::move(*--right);
+        }
+        std::move_backward(buffer, right, out);
+    }
+}
+
+// Sorts parts of the range on the pool, then merges them pairwise, the merges of each level in parallel. The merges
+// share a buffer of half the range taken from `resource`, each using the part of it matching its own part of the range.
+template <class T, class Compare>
+void sort_items(T* first, T* last, const Compare& compare, thread_pool* pool, std::pmr::memory_resource* resource)
+{
+    static constexpr std::size_t min_part_size = 4096;
+    const auto size = static_cast<std::size_t>(last - first);
+    const std::size_t parts = pool ? std::min(pool->size() + 1, size / min_part_size) : 1;
+    if (parts < 2)
+    {
+        std::sort(first, last, compare);
+        return;
+    }
+    const auto bound = [&](std::size_t part) { return first + size * std::min(part, parts) / parts; };
+    for_each_task(*pool, parts, [&](std::size_t part) { std::sort(bound(part), bound(part + 1), compare); });
+    std::pmr::vector<T> buffer(size / 2, resource);
+    for (std::size_t width = 1; width < parts; width *= 2)
+    {
+        for_each_task(
+            *pool,
+            (parts - width + 2 * width - 1) / (2 * width),
+            [&](std::size_t index)
+            {
+                const std::size_t part = index * 2 * width;
+                T* const begin = bound(part);
+                merge_items(
+                    begin, bound(part + width), bound(part + 2 * width), buffer.data() + (begin - first) / 2, compare);
+            });
+    }
+}
+
+// Temporary file holding sorted runs one after the other, each a segment of items, so that any number of runs costs
+// a single file descriptor.
+template <class T>
+class spill_file_t
+{
+public:
+    struct segment_t
+    {
+        std::size_t m_offset;
+        std::size_t m_count;
+    };
+
+    spill_file_t() : m_file{ std::tmpfile() }
+    {
+        if (!m_file)
+        {
+            throw std::system_error{ errno, std::generic_category(), "tmpfile" };
+        }
+    }
+
+    // Appends items to the segment being written.
+    void append(const T* data, std::size_t count)
+    {
+        seek(m_size);
+        if (std::fwrite(data, sizeof(T), count, m_file.get()) != count)
+        {
+            throw std::system_error{ errno, std::generic_category(), "fwrite" };
+        }
+        m_size += count;
+    }
+
+    // Ends the segment being written, returning it.
+    auto close_segment() -> segment_t
+    {
+        const segment_t segment{ m_segment_begin, m_size - m_segment_begin };
+        m_segment_begin = m_size;
+        return segment;
+    }
+
+    void read(std::size_t offset, T* data, std::size_t count)
+    {
+        seek(offset);
+        if (std::fread(data, sizeof(T), count, m_file.get()) != count)
+        {
+            throw std::system_error{ errno, std::generic_category(), "fread" };
+        }
+    }
+
+private:
+#if defined(__unix__) || defined(__APPLE__)
+    using file_offset_t = ::off_t;
+#elif defined(_WIN32)
+    using file_offset_t = __int64;
+#else
+    using file_offset_t = long;
+#endif
+
+    // Seeks with a 64 bit offset where the platform has one, since `long` is 32 bits wide on some of them.
+    void seek(std::size_t offset)
+    {
+        if (offset > static_cast<std::size_t>(std::numeric_limits<file_offset_t>::max()) / sizeof(T))
+        {
+            throw std::system_error{ EOVERFLOW, std::generic_category(), "seek" };
+        }
+        const auto position = static_cast<file_offset_t>(offset * sizeof(T));
+#if defined(__unix__) || defined(__APPLE__)
+        const int result = ::fseeko(m_file.get(), position, SEEK_SET);
+#elif defined(_WIN32)
+        const int result = ::_fseeki64(m_file.get(), position, SEEK_SET);
+#else
+        const int result = std::fseek(m_file.get(), position, SEEK_SET);
+#endif
+        if (result != 0)
+        {
+            throw std::system_error{ errno, std::generic_category(), "fseek" };
+        }
+    }
+
+    file_ptr_t m_file;
+    std::size_t m_size = 0;
+    std::size_t m_segment_begin = 0;
+};
+
+// Sorted run of a spill file, read back block by block.
+template <class T>
+class spilled_run_t
+{
+public:
+    using segment_t = typename spill_file_t<T>::segment_t;
+
+    spilled_run_t(spill_file_t<T>& file, segment_t segment, std::size_t block_size, std::pmr::memory_resource* resource)
+        : m_file{ &file }
+        , m_segment{ segment }
+        , m_block(std::min(block_size, segment.m_count), resource)
+    {
+        refill();
+    }
+
+    bool exhausted() const
+    {
+        return m_position == m_size;
+    }
+
+    auto current() const -> const T&
+    {
+        return m_block[m_position];
+    }
+
+    void advance()
+    {
+        if (++m_position == m_size)
+        {
+            refill();
+        }
+    }
+
+private:
+    void refill()
+    {
+        m_size = std::min(m_block.size(), m_segment.m_count);
+        m_position = 0;
+        m_file->read(m_segment.m_offset, m_block.data(), m_size);
+        m_segment.m_offset += m_size;
+        m_segment.m_count -= m_size;
+    }
+
+    spill_file_t<T>* m_file;
+    segment_t m_segment;
+    std::pmr::vector<T> m_block;
+    std::size_t m_size = 0;
+    std::size_t m_position = 0;
+};
+
+// Tournament tree over sorted sources which keeps in every inner node the loser of the match played there and the
+// overall winner at the root. Advancing the winner replays only the matches on its path to the root, so each item
+// costs log2(k) comparisons for k sources. Exhausted sources lose every match; ties go to the earlier source.
+template <class Source, class Compare>
+class loser_tree_t
+{
+public:
+    loser_tree_t(std::vector<Source>& sources, const Compare& compare)
+        : m_sources{ sources }
+        , m_compare{ compare }
+        , m_tree(sources.size())
+    {
+        const std::size_t count = sources.size();
+        std::vector<std::size_t> winners(2 * count);
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            winners[count + index] = index;
+        }
+        for (std::size_t node = count - 1; node > 0; --node)
+        {
+            const std::size_t lhs = winners[2 * node];
+            const std::size_t rhs = winners[2 * node + 1];
+            winners[node] = beats(lhs, rhs) ? lhs : rhs;
+            m_tree[node] = beats(lhs, rhs) ? rhs : lhs;
+        }
+        m_tree[0] = count > 1 ? winners[1] : 0;
+    }
+
+    bool empty() const
+    {
+        return m_sources[m_tree[0]].exhausted();
+    }
+
+    auto top() const -> const Source&
+    {
+        return m_sources[m_tree[0]];
+    }
+
+    void pop()
+    {
+        std::size_t winner = m_tree[0];
+        m_sources[winner].advance();
+        for (std::size_t node = (winner + m_sources.size()) / 2; node > 0; node /= 2)
+        {
+            if (beats(m_tree[node], winner))
+            {
+                std::swap(m_tree[node], winner);
+            }
+        }
+        m_tree[0] = winner;
+    }
+
+private:
+    bool beats(std::size_t lhs, std::size_t rhs) const
+    {
+        if (m_sources[lhs].exhausted() || m_sources[rhs].exhausted())
+        {
+            return !m_sources[lhs].exhausted() || (m_sources[rhs].exhausted() && lhs < rhs);
+        }
+        const auto& a = m_sources[lhs].current();
+        const auto& b = m_sources[rhs].current();
+        return std::invoke(m_compare, a, b) || (!std::invoke(m_compare, b, a) && lhs < rhs);
+    }
+
+    std::vector<Source>& m_sources;
+    const Compare& m_compare;
+    std::vector<std::size_t> m_tree;
+};
+
+template <class T>
+struct sort_fn
+{
+    static_assert(std::is_trivially_copyable_v<T>, "sort spills the items to files as bytes");
+
+    template <class Reducer, class Compare>
+    struct reducer_t
+    {
+        Reducer m_next_reducer;
+        Compare m_compare;
+        sort_options m_options;
+
+        struct run_t
+        {
+            using segment_t = typename spill_file_t<T>::segment_t;
+
+            start_result_t<Reducer> m_next;
+            const reducer_t* m_reducer;
+            run_context m_context;
+            std::pmr::vector<T> m_buffer;
+            std::optional<spill_file_t<T>> m_spill_file = {};
+            std::vector<segment_t> m_segments = {};
+
+            template <class State, class... Args>
+            void operator()(State&, Args&&... args)
+            {
+                if (m_buffer.size() == m_buffer.capacity())
+                {
+                    m_buffer.reserve(std::min(std::max(2 * m_buffer.capacity(), std::size_t{ 16 }), limit()));
+                }
+                m_buffer.emplace_back(std::forward<Args>(args)...);
+                if (m_buffer.size() == limit())
+                {
+                    spill();
+                }
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            void complete(State& state)
+            {
+                if (m_segments.empty())
+                {
+                    sort_buffer();
+                    for (auto it = m_buffer.begin(); it != m_buffer.end() && !is_done(m_next); ++it)
+                    {
+                        step(m_next, state, *it);
+                    }
+                }
+                else
+                {
+                    if (!m_buffer.empty())
+                    {
+                        spill();
+                    }
+                    m_buffer = std::pmr::vector<T>{ m_context.resource };
+                    while (m_segments.size() > merge_width)
+                    {
+                        merge_pass();
+                    }
+                    if (!is_done(m_next))
+                    {
+                        merge(
+                            m_segments.data(),
+                            m_segments.data() + m_segments.size(),
+                            std::max(limit() / m_segments.size(), std::size_t{ 1 }),
+                            [&](const T& item)
+                            {
+                                step(m_next, state, item);
+                                return !is_done(m_next);
+                            });
+                    }
+                    m_spill_file.reset();
+                }
+                detail::complete(m_next, state);
+            }
+
+        private:
+            // Number of runs merged at once; more are first merged into longer runs, in as many passes as it takes.
+            // It keeps the read blocks sharing the memory budget large enough.
+            static constexpr std::size_t merge_width = 64;
+
+            auto compare() const -> const Compare&
+            {
+                return m_reducer->m_compare;
+            }
+
+            // Number of items held before spilling. Sorting on a pool takes a buffer of half of them for the merges, so
+            // they are kept to two thirds of the budget then.
+            auto limit() const -> std::size_t
+            {
+                const std::size_t items = m_reducer->m_options.memory_budget / sizeof(T);
+                return std::max(m_reducer->m_options.pool ? items / 3 * 2 : items, std::size_t{ 1 });
+            }
+
+            void sort_buffer()
+            {
+                sort_items(
+                    m_buffer.data(),
+                    m_buffer.data() + m_buffer.size(),
+                    compare(),
+                    m_reducer->m_options.pool,
+                    m_context.resource);
+            }
+
+            void spill()
+            {
+                sort_buffer();
+                if (!m_spill_file)
+                {
+                    m_spill_file.emplace();
+                }
+                m_spill_file->append(m_buffer.data(), m_buffer.size());
+                m_segments.push_back(m_spill_file->close_segment());
+                m_buffer.clear();
+            }
+
+            // Calls `emit(item)` on the items of the runs in order, as long as it returns true. The runs are read in
+            // blocks of `block_size` items.
+            template <class Emit>
+            void merge(const segment_t* first, const segment_t* last, std::size_t block_size, Emit emit)
+            {
+                std::vector<spilled_run_t<T>> runs;
+                runs.reserve(static_cast<std::size_t>(last - first));
+                for (; first != last; ++first)
+                {
+                    runs.emplace_back(*m_spill_file, *first, block_size, m_context.resource);
+                }
+                for (loser_tree_t<spilled_run_t<T>, Compare> tree{ runs, compare() };
+                     !tree.empty() && emit(tree.top().current());
+                     tree.pop())
+                {
+                }
+            }
+
+            // Merges every `merge_width` runs into one, written to a new spill file which replaces the current one.
+            // The memory budget is shared among the read blocks of the runs and the write block.
+            void merge_pass()
+            {
+                const std::size_t block_size = std::max(limit() / (merge_width + 1), std::size_t{ 1 });
+                spill_file_t<T> output;
+                std::vector<segment_t> segments;
+                std::pmr::vector<T> block{ m_context.resource };
+                block.reserve(block_size);
+                for (std::size_t first = 0; first < m_segments.size(); first += merge_width)
+                {
+                    const std::size_t last = std::min(first + merge_width, m_segments.size());
+                    merge(
+                        m_segments.data() + first,
+                        m_segments.data() + last,
+                        block_size,
+                        [&](const T& item)
+                        {
+                            block.push_back(item);
+                            if (block.size() == block_size)
+                            {
+                                output.append(block.data(), block.size());
+                                block.clear();
+                            }
+                            return true;
+                        });
+                    output.append(block.data(), block.size());
+                    block.clear();
+                    segments.push_back(output.close_segment());
+                }
+                m_spill_file = std::move(output);
+                m_segments = std::move(segments);
+            }
+        };
+
+        auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), this, context, std::pmr::vector<T>{ context.resource } };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count);
+        }
+    };
+
+    template <class Compare>
+    struct transducer_t
+    {
+        Compare m_compare;
+        sort_options m_options;
+
+        template <class Reducer>
+        constexpr auto operator()(Reducer&& next_reducer) const
+            -> reducer_interface_t<reducer_t<std::decay_t<Reducer>, Compare>>
+        {
+            return { { std::forward<Reducer>(next_reducer), m_compare, m_options } };
+        }
+    };
+
+    template <class Compare = std::less<>>
+    constexpr auto operator()(Compare compare = {}) const -> transducer_interface_t<transducer_t<Compare>>
+    {
+        return { { std::move(compare), sort_options{} } };
+    }
+
+    template <class Compare = std::less<>>
+    constexpr auto operator()(sort_options options, Compare compare = {}) const
+        -> transducer_interface_t<transducer_t<Compare>>
+    {
+        return { { std::move(compare), options } };
+    }
+};
+
+}  // namespace detail
+
+// Passes all the items downstream on completion, ordered by `compare`; the order of equivalent items is unspecified.
+// Up to `memory_budget` bytes of items are sorted in memory; beyond that, full buffers are sorted and spilled as runs
+// to a temporary file (std::tmpfile), which are merged at completion through a loser tree reading them in blocks that
+// share the same budget. Past 64 runs, they are first merged 64 at a time into a new file, in as many passes as
+// needed, so a run holds at most two files open. Items are spilled as bytes, so `T` must be trivially copyable.
+template <class T>
+static constexpr inline auto sort = detail::sort_fn<T>{};
+
+}  // namespace dux
+}  // namespace ferrugo
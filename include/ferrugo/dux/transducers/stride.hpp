@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ferrugo/dux/interfaces.hpp>
+#include <ferrugo/dux/span.hpp>
 
 namespace ferrugo
 {
@@ -17,12 +18,62 @@ struct stride_fn
     {
         Reducer m_next_reducer;
         std::ptrdiff_t m_count;
-        mutable std::ptrdiff_t m_index = 0;
 
-        template <class State, class... Args>
-        constexpr auto operator()(State state, Args&&... args) const -> State
+        struct run_t
         {
-            return (m_index++ % m_count) == 0 ? m_next_reducer(std::move(state), std::forward<Args>(args)...) : state;
+            start_result_t<Reducer> m_next;
+            std::ptrdiff_t m_count;
+            std::ptrdiff_t m_index = 0;
+
+            template <class State, class... Args>
+            constexpr void operator()(State& state, Args&&... args)
+            {
+                if ((m_index++ % m_count) == 0)
+                {
+                    step(m_next, state, std::forward<Args>(args)...);
+                }
+            }
+
+            // Visits only the selected items, skipping the others without a step each.
+            template <class State, class T>
+            constexpr void step_batch(State& state, span_t<T> items)
+            {
+                const auto size = static_cast<std::ptrdiff_t>(items.size());
+                std::ptrdiff_t index = (m_count - m_index % m_count) % m_count;
+                m_index += size;
+                for (; index < size && !is_done(m_next); index += m_count)
+                {
+                    step(m_next, state, items[index]);
+                }
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            constexpr void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_count, 0 };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            const auto step = static_cast<std::size_t>(m_count);
+            return detail::size_hint(m_next_reducer, (count + step - 1) / step);
         }
     };
 
@@ -33,7 +84,7 @@ struct stride_fn
         template <class Reducer>
         constexpr auto operator()(Reducer&& next_reducer) const -> reducer_interface_t<reducer_t<std::decay_t<Reducer>>>
         {
-            return { { std::forward<Reducer>(next_reducer), m_count, 0 } };
+            return { { std::forward<Reducer>(next_reducer), m_count } };
         }
     };
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <ferrugo/dux/interfaces.hpp>
+#include <ferrugo/dux/span.hpp>
 
 namespace ferrugo
 {
@@ -16,12 +18,58 @@ struct take_fn
     struct reducer_t
     {
         Reducer m_next_reducer;
-        mutable std::ptrdiff_t m_count;
+        std::ptrdiff_t m_count;
+
+        struct run_t
+        {
+            start_result_t<Reducer> m_next;
+            std::ptrdiff_t m_count;
+
+            template <class State, class... Args>
+            constexpr void operator()(State& state, Args&&... args)
+            {
+                if (m_count-- > 0)
+                {
+                    step(m_next, state, std::forward<Args>(args)...);
+                }
+            }
+
+            template <class State, class T>
+            constexpr void step_batch(State& state, span_t<T> items)
+            {
+                const auto remaining = static_cast<std::size_t>(std::max(m_count, std::ptrdiff_t{ 0 }));
+                const auto count = std::min(remaining, items.size());
+                m_count -= static_cast<std::ptrdiff_t>(count);
+                detail::step_batch(m_next, state, items.subspan(0, count));
+            }
+
+            constexpr bool done() const
+            {
+                return m_count <= 0 || is_done(m_next);
+            }
+
+            template <class State>
+            constexpr void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_count };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
 
-        template <class State, class... Args>
-        constexpr auto operator()(State state, Args&&... args) const -> State
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
         {
-            return m_count-- > 0 ? m_next_reducer(std::move(state), std::forward<Args>(args)...) : state;
+            const auto limit = static_cast<std::size_t>(std::max(m_count, std::ptrdiff_t{ 0 }));
+            return detail::size_hint(m_next_reducer, std::min(count, limit));
         }
     };
 
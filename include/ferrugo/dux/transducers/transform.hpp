@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ferrugo/dux/interfaces.hpp>
+#include <ferrugo/dux/simd.hpp>
 
 namespace ferrugo
 {
@@ -21,10 +22,45 @@ struct transform_fn
         Reducer m_next_reducer;
         Func m_func;
 
-        template <class State, class... Args>
-        constexpr auto operator()(State state, Args&&... args) const -> State
+        struct run_t
         {
-            return m_next_reducer(std::move(state), std::invoke(m_func, std::forward<Args>(args)...));
+            static constexpr bool stateless = is_stateless_run<start_result_t<Reducer>>::value;
+
+            start_result_t<Reducer> m_next;
+            const Func& m_func;
+
+            template <class State, class... Args>
+            constexpr void operator()(State& state, Args&&... args)
+            {
+                step(m_next, state, std::invoke(m_func, std::forward<Args>(args)...));
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            constexpr void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_func };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count);
         }
     };
 
@@ -33,12 +69,45 @@ struct transform_fn
     {
         Reducer m_next_reducer;
         Func m_func;
-        mutable std::ptrdiff_t m_index = 0;
 
-        template <class State, class... Args>
-        constexpr auto operator()(State state, Args&&... args) const -> State
+        struct run_t
+        {
+            start_result_t<Reducer> m_next;
+            const Func& m_func;
+            std::ptrdiff_t m_index = 0;
+
+            template <class State, class... Args>
+            constexpr void operator()(State& state, Args&&... args)
+            {
+                step(m_next, state, std::invoke(m_func, m_index++, std::forward<Args>(args)...));
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            constexpr void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+        };
+
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_func };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
         {
-            return m_next_reducer(std::move(state), std::invoke(m_func, m_index++, std::forward<Args>(args)...));
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count);
         }
     };
 
@@ -62,6 +131,23 @@ struct transform_fn
     }
 };
 
+template <class Reducer, class Func>
+struct simd_traits<typename transform_fn<false>::template reducer_t<false, Reducer, Func>> : simd_traits<Reducer>
+{
+    using reducer_type = typename transform_fn<false>::template reducer_t<false, Reducer, Func>;
+
+    static constexpr auto op(const reducer_type& reducer)
+    {
+        return simd_traits<Reducer>::op(reducer.m_next_reducer);
+    }
+
+    static constexpr auto projection(const reducer_type& reducer)
+    {
+        return [&func = reducer.m_func, proj = simd_traits<Reducer>::projection(reducer.m_next_reducer)](const auto& item)
+        { return std::invoke(proj, std::invoke(func, item)); };
+    }
+};
+
 }  // namespace detail
 
 static constexpr inline auto transform = detail::transform_fn<false>{};
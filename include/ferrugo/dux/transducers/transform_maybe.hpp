@@ -21,15 +21,48 @@ struct transform_maybe_fn
         Reducer m_next_reducer;
         Func m_func;
 
-        template <class State, class... Args>
-        constexpr auto operator()(State state, Args&&... args) const -> State
+        struct run_t
         {
-            if (auto res = std::invoke(m_func, std::forward<Args>(args)...))
+            static constexpr bool stateless = is_stateless_run<start_result_t<Reducer>>::value;
+
+            start_result_t<Reducer> m_next;
+            const Func& m_func;
+
+            template <class State, class... Args>
+            constexpr void operator()(State& state, Args&&... args)
+            {
+                if (auto res = std::invoke(m_func, std::forward<Args>(args)...))
+                {
+                    step(m_next, state, *std::move(res));
+                }
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            constexpr void complete(State& state)
             {
-                return m_next_reducer(std::move(state), *std::move(res));
+                detail::complete(m_next, state);
             }
+        };
 
-            return state;
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_func };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count);
         }
     };
 
@@ -38,17 +71,48 @@ struct transform_maybe_fn
     {
         Reducer m_next_reducer;
         Func m_func;
-        mutable std::ptrdiff_t m_index = 0;
 
-        template <class State, class... Args>
-        constexpr auto operator()(State state, Args&&... args) const -> State
+        struct run_t
         {
-            if (auto res = std::invoke(m_func, m_index++, std::forward<Args>(args)...))
+            start_result_t<Reducer> m_next;
+            const Func& m_func;
+            std::ptrdiff_t m_index = 0;
+
+            template <class State, class... Args>
+            constexpr void operator()(State& state, Args&&... args)
+            {
+                if (auto res = std::invoke(m_func, m_index++, std::forward<Args>(args)...))
+                {
+                    step(m_next, state, *std::move(res));
+                }
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            constexpr void complete(State& state)
             {
-                return m_next_reducer(std::move(state), *std::move(res));
+                detail::complete(m_next, state);
             }
+        };
 
-            return state;
+        constexpr auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_func };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count);
         }
     };
 
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <ferrugo/dux/interfaces.hpp>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+namespace detail
+{
+
+template <class T>
+struct window_fn
+{
+    template <class Reducer, class Op>
+    struct reducer_t
+    {
+        Reducer m_next_reducer;
+        Op m_op;
+        std::size_t m_size;
+
+        // The window is a queue made of two stacks sharing one ring of `m_size` slots. The older items (the front) are
+        // stored as suffix aggregates, so that the front slot holds the aggregate of the whole front; the newer ones
+        // (the back) are stored as they come, with their aggregate kept aside. Once the front runs out the back is
+        // turned into the front in a single pass, so every item is combined a constant number of times.
+        struct run_t
+        {
+            start_result_t<Reducer> m_next;
+            const Op& m_op;
+            std::pmr::vector<T> m_ring;
+            T m_back = {};
+            std::size_t m_head = 0;
+            std::size_t m_front_size = 0;
+            std::size_t m_back_size = 0;
+
+            template <class State, class... Args>
+            void operator()(State& state, Args&&... args)
+            {
+                T item(std::forward<Args>(args)...);
+                if (m_front_size + m_back_size == m_ring.size())
+                {
+                    pop();
+                }
+                m_back = m_back_size == 0 ? item : T(std::invoke(m_op, std::move(m_back), item));
+                m_ring[wrap(m_head + m_front_size + m_back_size)] = std::move(item);
+                ++m_back_size;
+                if (m_front_size + m_back_size == m_ring.size())
+                {
+                    step(m_next, state, aggregate());
+                }
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            void complete(State& state)
+            {
+                detail::complete(m_next, state);
+            }
+
+        private:
+            auto wrap(std::size_t index) const -> std::size_t
+            {
+                return index >= m_ring.size() ? index - m_ring.size() : index;
+            }
+
+            void pop()
+            {
+                if (m_front_size == 0)
+                {
+                    for (std::size_t i = m_back_size - 1; i-- > 0;)
+                    {
+                        const std::size_t index = wrap(m_head + i);
+                        m_ring[index] = std::invoke(m_op, std::move(m_ring[index]), m_ring[wrap(index + 1)]);
+                    }
+                    m_front_size = std::exchange(m_back_size, 0);
+                }
+                m_head = wrap(m_head + 1);
+                --m_front_size;
+            }
+
+            auto aggregate() const -> T
+            {
+                if (m_front_size == 0)
+                {
+                    return m_back;
+                }
+                if (m_back_size == 0)
+                {
+                    return m_ring[m_head];
+                }
+                return std::invoke(m_op, m_ring[m_head], m_back);
+            }
+        };
+
+        auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), m_op, std::pmr::vector<T>(m_size, context.resource) };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, count >= m_size ? count - m_size + 1 : 0);
+        }
+    };
+
+    template <class Op>
+    struct transducer_t
+    {
+        Op m_op;
+        std::size_t m_size;
+
+        template <class Reducer>
+        constexpr auto operator()(Reducer&& next_reducer) const
+            -> reducer_interface_t<reducer_t<std::decay_t<Reducer>, Op>>
+        {
+            return { { std::forward<Reducer>(next_reducer), m_op, m_size } };
+        }
+    };
+
+    template <class Op>
+    constexpr auto operator()(std::ptrdiff_t size, Op&& op) const -> transducer_interface_t<transducer_t<std::decay_t<Op>>>
+    {
+        return { { std::forward<Op>(op), static_cast<std::size_t>(std::max(size, std::ptrdiff_t{ 1 })) } };
+    }
+};
+
+struct tumbling_fn
+{
+    template <class Reducer, class WindowReducer, class WindowState>
+    struct reducer_t
+    {
+        Reducer m_next_reducer;
+        WindowReducer m_window_reducer;
+        WindowState m_init;
+        std::size_t m_size;
+
+        struct run_t
+        {
+            start_result_t<Reducer> m_next;
+            const reducer_t* m_reducer;
+            run_context m_context;
+            WindowState m_window;
+            std::optional<start_result_t<WindowReducer>> m_window_run = {};
+            std::size_t m_count = 0;
+
+            template <class State, class... Args>
+            void operator()(State& state, Args&&... args)
+            {
+                if (!m_window_run)
+                {
+                    m_window_run.emplace(detail::start(m_reducer->m_window_reducer, m_context));
+                }
+                if (!is_done(*m_window_run))
+                {
+                    step(*m_window_run, m_window, std::forward<Args>(args)...);
+                }
+                if (++m_count == m_reducer->m_size)
+                {
+                    flush(state);
+                }
+            }
+
+            constexpr bool done() const
+            {
+                return is_done(m_next);
+            }
+
+            template <class State>
+            void complete(State& state)
+            {
+                if (m_count > 0 && !is_done(m_next))
+                {
+                    flush(state);
+                }
+                detail::complete(m_next, state);
+            }
+
+        private:
+            template <class State>
+            void flush(State& state)
+            {
+                detail::complete(*m_window_run, m_window);
+                step(m_next, state, std::move(m_window));
+                m_window = m_reducer->m_init;
+                m_window_run.reset();
+                m_count = 0;
+            }
+        };
+
+        auto start(const run_context& context = {}) const -> run_t
+        {
+            return { detail::start(m_next_reducer, context), this, context, m_init };
+        }
+
+        template <class R = Reducer>
+        constexpr auto init() const -> decltype(detail::init(std::declval<const R&>()))
+        {
+            return detail::init(m_next_reducer);
+        }
+
+        constexpr auto size_hint(std::size_t count) const -> std::optional<std::size_t>
+        {
+            return detail::size_hint(m_next_reducer, (count + m_size - 1) / m_size);
+        }
+    };
+
+    template <class WindowReducer, class WindowState>
+    struct transducer_t
+    {
+        WindowReducer m_window_reducer;
+        WindowState m_init;
+        std::size_t m_size;
+
+        template <class Reducer>
+        constexpr auto operator()(Reducer&& next_reducer) const
+            -> reducer_interface_t<reducer_t<std::decay_t<Reducer>, WindowReducer, WindowState>>
+        {
+            return { { std::forward<Reducer>(next_reducer), m_window_reducer, m_init, m_size } };
+        }
+    };
+
+    template <class WindowState, class WindowReducer>
+    constexpr auto operator()(std::ptrdiff_t size, WindowState init, WindowReducer&& reducer) const
+        -> transducer_interface_t<transducer_t<std::decay_t<WindowReducer>, WindowState>>
+    {
+        return { { std::forward<WindowReducer>(reducer),
+                   std::move(init),
+                   static_cast<std::size_t>(std::max(size, std::ptrdiff_t{ 1 })) } };
+    }
+
+    template <class WindowReducer>
+    constexpr auto operator()(std::ptrdiff_t size, WindowReducer&& reducer) const
+        -> transducer_interface_t<transducer_t<std::decay_t<WindowReducer>, decltype(detail::init(reducer))>>
+    {
+        auto init = detail::init(reducer);
+        return (*this)(size, std::move(init), std::forward<WindowReducer>(reducer));
+    }
+};
+
+}  // namespace detail
+
+// Sliding window over the last `size` items, combined with the associative binary operation `op` (e.g. sum, min,
+// max), passed downstream as a `T` once for every item from the `size`-th on. The window lives in a ring of `size`
+// items taken once per run from the resource of the run context, and each step costs a constant number of `op`
+// calls on average, whatever the window size. `op` need not be commutative: items are combined oldest first.
+template <class T>
+static constexpr inline auto window = detail::window_fn<T>{};
+
+// Splits the items into consecutive windows of `size` items, reduces each of them with `reducer` starting from
+// `init` (or from the reducer's own `init()`), and passes each window's result downstream; the trailing partial
+// window is emitted on completion.
+static constexpr inline auto tumbling = detail::tumbling_fn{};
+
+}  // namespace dux
+}  // namespace ferrugo
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <ferrugo/dux/interfaces.hpp>
+#include <ferrugo/dux/spsc_queue.hpp>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ferrugo
+{
+namespace dux
+{
+
+// Tuning of the stages that hand items over to other threads: items travel in batches of `batch_size` and at most
+// `queue_size` batches wait for a consumer before the producer is stalled.
+struct batch_options
+{
+    std::size_t batch_size = 1024;
+    std::size_t queue_size = 16;
+};
+
+namespace detail
+{
+
+// Batches are filled once by the producer and then only read, so several consumers may share the same one.
+template <class T>
+using batch_t = std::shared_ptr<const std::vector<T>>;
+
+template <class T>
+struct worker_base_t
+{
+    virtual ~worker_base_t() = default;
+    virtual void push(const batch_t<T>& batch) = 0;
+    virtual bool done() const = 0;
+};
+
+// Thread consuming batches of `T` with a run of `Reducer`, started with the context of the run handing the batches
+// over. It owns its part of the state from construction until `take_state()`; an empty batch marks the end of the
+// input.
+template <class T, class Reducer, class State>
+class batch_worker_t : public worker_base_t<T>
+{
+public:
+    batch_worker_t(const Reducer& reducer, State state, std::size_t queue_size, const run_context& context)
+        : m_queue{ queue_size }
+        , m_state{ std::move(state) }
+        , m_context{ context }
+    {
+        m_thread = std::thread{ [this, &reducer] { consume(reducer); } };
+    }
+
+    ~batch_worker_t() override
+    {
+        join();
+    }
+
+    void push(const batch_t<T>& batch) override
+    {
+        if (!m_done.load(std::memory_order_relaxed))
+        {
+            m_queue.push(batch);
+        }
+    }
+
+    bool done() const override
+    {
+        return m_done.load(std::memory_order_relaxed);
+    }
+
+    void join()
+    {
+        if (m_thread.joinable())
+        {
+            m_queue.push(nullptr);
+            m_thread.join();
+        }
+    }
+
+    auto error() const -> std::exception_ptr
+    {
+        return m_error;
+    }
+
+    auto take_state() -> State&&
+    {
+        return std::move(m_state);
+    }
+
+private:
+    void consume(const Reducer& reducer)
+    {
+        try
+        {
+            auto run = detail::start(reducer, m_context);
+            while (const batch_t<T> batch = m_queue.pop())
+            {
+                for (auto it = batch->begin(); it != batch->end() && !is_done(run); ++it)
+                {
+                    step(run, m_state, *it);
+                }
+                if (is_done(run))
+                {
+                    m_done.store(true, std::memory_order_relaxed);
+                }
+            }
+            detail::complete(run, m_state);
+        }
+        catch (...)
+        {
+            m_error = std::current_exception();
+            m_done.store(true, std::memory_order_relaxed);
+            while (m_queue.pop())
+            {
+            }
+        }
+    }
+
+    spsc_queue_t<batch_t<T>> m_queue;
+    State m_state;
+    run_context m_context;
+    std::atomic<bool> m_done{ false };
+    std::exception_ptr m_error;
+    std::thread m_thread;
+};
+
+// Producer side: collects items into the current batch and hands full batches to the worker.
+template <class T>
+struct batch_sender_t
+{
+    batch_options m_options;
+    std::vector<T> m_batch = {};
+    std::unique_ptr<worker_base_t<T>> m_worker = {};
+    bool m_done = false;
+
+    template <class... Args>
+    void add(Args&&... args)
+    {
+        if (m_batch.capacity() == 0)
+        {
+            m_batch.reserve(m_options.batch_size);
+        }
+        m_batch.emplace_back(std::forward<Args>(args)...);
+        if (m_batch.size() >= m_options.batch_size)
+        {
+            flush();
+        }
+    }
+
+    // The worker is polled once per batch, so that `done()` costs nothing per item.
+    void flush()
+    {
+        if (m_batch.empty())
+        {
+            return;
+        }
+        m_worker->push(std::make_shared<const std::vector<T>>(std::move(m_batch)));
+        m_batch = std::vector<T>{};
+        m_batch.reserve(m_options.batch_size);
+        m_done = m_worker->done();
+    }
+};
+
+constexpr auto normalize(batch_options options) -> batch_options
+{
+    options.batch_size = std::max(options.batch_size, std::size_t{ 1 });
+    options.queue_size = std::max(options.queue_size, std::size_t{ 1 });
+    return options;
+}
+
+}  // namespace detail
+}  // namespace dux
+}  // namespace ferrugo
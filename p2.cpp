@@ -0,0 +1,9 @@
+#include <ferrugo/dux.hpp>
+#include <vector>
+#include <cstdio>
+namespace dux = ferrugo::dux;
+int main(){
+  std::vector<int> v{1,2,3,4};
+  int n = dux::reduce(0, dux::take(2) |= [](int s, int& x){ x = 0; return s + 1; })(v);
+  std::printf("%d %d\n", n, v[0]);
+}
@@ -1,6 +1,21 @@
+#include <array>
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
 #include <ferrugo/dux/dux.hpp>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <memory_resource>
+#include <numeric>
 #include <optional>
+#include <thread>
+#include <unordered_map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #include "matchers.hpp"
 
@@ -41,6 +56,25 @@ struct delimit
     }
 };
 
+struct bracket
+{
+    auto init() const -> std::string
+    {
+        return "[";
+    }
+
+    template <class T>
+    auto operator()(std::string total, const T& item) const -> std::string
+    {
+        return total + str(item);
+    }
+
+    auto complete(std::string total) const -> std::string
+    {
+        return total + "]";
+    }
+};
+
 static constexpr inline struct min_value_fn
 {
     template <class T>
@@ -88,6 +122,62 @@ TEST_CASE("reduce", "[reducers]")
         matchers::equal_to(14));
 }
 
+TEST_CASE("reduce over contiguous arithmetic ranges", "[reducers]")
+{
+    std::vector<int> in(1001);
+    std::iota(in.begin(), in.end(), -500);
+    const std::vector<double> in_d(in.begin(), in.end());
+
+    REQUIRE_THAT(  //
+        dux::reduce(7, std::plus{})(in),
+        matchers::equal_to(std::accumulate(in.begin(), in.end(), 7)));
+
+    REQUIRE_THAT(  //
+        dux::reduce(0.5, std::plus{})(in_d),
+        matchers::equal_to(std::accumulate(in_d.begin(), in_d.end(), 0.5)));
+
+    REQUIRE_THAT(  //
+        dux::reduce(1.0, std::multiplies{})(std::vector<double>(100, 2.0)),
+        matchers::equal_to(std::pow(2.0, 100)));
+
+    REQUIRE_THAT(  //
+        dux::reduce(std::numeric_limits<int>::max(), dux::minimum)(in),
+        matchers::equal_to(-500));
+
+    REQUIRE_THAT(  //
+        dux::reduce(std::numeric_limits<int>::min(), dux::maximum)(in),
+        matchers::equal_to(500));
+
+    REQUIRE_THAT(  //
+        dux::reduce(0.0, dux::transform([](int x) { return 0.5 * x * x; }) | std::plus{})(in),
+        matchers::equal_to(dux::reduce(0.0, [](double total, int x) { return total + 0.5 * x * x; })(in)));
+
+    REQUIRE_THAT(  //
+        dux::reduce(0, std::plus{})(std::vector<int>{ 1, 2, 3 }),
+        matchers::equal_to(6));
+}
+
+TEST_CASE("reduce with init and complete", "[reducers]")
+{
+    const std::vector<int> in = { 2, 3, 5, 7, 9 };
+
+    REQUIRE_THAT(  //
+        dux::reduce(bracket{})(in),
+        matchers::equal_to("[23579]"));
+
+    REQUIRE_THAT(  //
+        dux::reduce(std::string{ "<" }, bracket{})(in),
+        matchers::equal_to("<23579]"));
+
+    REQUIRE_THAT(  //
+        in | dux::reduce(dux::filter([](int x) { return x > 4; }) | dux::take(2) | bracket{}),
+        matchers::equal_to("[57]"));
+
+    REQUIRE_THAT(  //
+        dux::reduce(std::string{}, dux::fork(dux::take(1) | bracket{}, dux::drop(4) | bracket{}))(in),
+        matchers::equal_to("29]]"));
+}
+
 TEST_CASE("transform", "[transducers]")
 {
     const auto xform = dux::transform(str);
@@ -162,6 +252,71 @@ TEST_CASE("take", "[transducers]")
         matchers::elements_are(2, 3, 5));
 }
 
+TEST_CASE("stateful reducer is called through its run", "[reducers]")
+{
+    const std::vector<int> in = { 1, 2, 3, 4 };
+    const auto first_two = dux::take(2)(std::plus<>{});
+    const auto sum = dux::transform([](int x) { return x; })(std::plus<>{});
+
+    static_assert(!std::is_invocable_v<decltype(first_two), int, int>);
+    static_assert(std::is_invocable_v<decltype(sum), int, int>);
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        auto run = first_two.start();
+        int total = 0;
+        for (int x : in)
+        {
+            run(total, x);
+        }
+        REQUIRE_THAT(  //
+            total,
+            matchers::equal_to(3));
+    }
+}
+
+TEST_CASE("stateless reducer may be called directly from several threads", "[reducers]")
+{
+    std::vector<int> in(10000);
+    std::iota(in.begin(), in.end(), 0);
+    const auto sum_of_twice = dux::transform([](int x) { return 2 * x; })(std::plus<>{});
+
+    std::vector<long long> sums(4);
+    std::vector<int> maxima(4);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < sums.size(); ++i)
+    {
+        threads.emplace_back(
+            [&, i]()
+            {
+                sums[i] = std::accumulate(in.begin(), in.end(), 0LL, sum_of_twice);
+                maxima[i] = std::accumulate(in.begin(), in.end(), 0, dux::maximum);
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(sums == std::vector<long long>(4, 99990000LL));
+    REQUIRE(maxima == std::vector<int>(4, 9999));
+}
+
+TEST_CASE("take stops the reduction early", "[transducers]")
+{
+    std::ptrdiff_t visited = 0;
+    const auto xform = dux::inspect([&](int) { ++visited; }) | dux::take(3);
+    const std::vector<int> in = { 2, 3, 5, 7, 9, 11, 12, 13, 14 };
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, xform, in),
+        matchers::elements_are(2, 3, 5));
+
+    REQUIRE_THAT(  //
+        visited,
+        matchers::equal_to(3));
+}
+
 TEST_CASE("drop", "[transducers]")
 {
     const auto xform = dux::drop(3);
@@ -182,6 +337,168 @@ TEST_CASE("stride", "[transducers]")
         matchers::elements_are(2, 7, 12));
 }
 
+TEST_CASE("distinct", "[transducers]")
+{
+    const std::vector<int> in = { 3, 1, 3, 2, 1, 5, 2, 3, 4 };
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::distinct<int>(), in),
+        matchers::elements_are(3, 1, 2, 5, 4));
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::distinct<int>([](int x) { return x % 3; }) | dux::transform(std::negate<>{}), in),
+        matchers::elements_are(-3, -1, -2));
+    REQUIRE_THAT(  //
+        dux::into(
+            std::vector<int>{}, dux::filter([](int x) { return x > 1; }) | dux::distinct<int>(dux::bloom_options{}), in),
+        matchers::elements_are(3, 2, 5, 4));
+
+    const std::vector<std::string_view> words = { "b", "a", "b", "c", "a" };
+    REQUIRE_THAT(  //
+        dux::into(std::vector<std::string_view>{}, dux::distinct<std::string>(), words),
+        matchers::elements_are("b", "a", "c"));
+}
+
+TEST_CASE("distinct allocates the seen keys from the run context", "[transducers]")
+{
+    std::vector<int> in(1000);
+    std::iota(in.begin(), in.end(), 0);
+    const auto tens = [](int x) { return x / 10; };
+
+    // The arena has no fallback upstream, so the keys must come from its buffer and be released after each reduction.
+    alignas(std::max_align_t) std::byte buffer[8192];
+    dux::arena arena{ buffer, sizeof(buffer), std::pmr::null_memory_resource() };
+
+    const auto first_of_tens = dux::distinct<int>(tens) | dux::transform(tens) | std::plus<>{};
+    const auto first_of_tens_bloom = dux::distinct<int>(dux::bloom_options{ 100, 0.001 }, tens) | std::plus<>{};
+    for (int i = 0; i < 3; ++i)
+    {
+        REQUIRE_THAT(  //
+            dux::reduce(0, first_of_tens, arena)(in),
+            matchers::equal_to(4950));
+        REQUIRE_THAT(  //
+            dux::reduce(0, first_of_tens_bloom, arena)(in),
+            matchers::less_equal(49500));
+    }
+    REQUIRE_THROWS_AS(dux::reduce(0, dux::distinct<int>() | std::plus<>{}, arena)(in), std::bad_alloc);
+}
+
+TEST_CASE("bloom_filter", "[containers]")
+{
+    dux::bloom_filter<int> filter{ dux::bloom_options{ 10000, 0.01 } };
+    int added = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        added += filter.insert(i * 7) ? 1 : 0;
+    }
+    REQUIRE_THAT(  //
+        added,
+        matchers::greater(9700));
+    for (int i = 0; i < 10000; ++i)
+    {
+        REQUIRE(filter.contains(i * 7));
+        REQUIRE(!filter.insert(i * 7));
+    }
+
+    int false_positives = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        false_positives += filter.contains(i * 7 + 3) ? 1 : 0;
+    }
+    REQUIRE_THAT(  //
+        false_positives,
+        matchers::less(300));
+}
+
+TEST_CASE("window", "[transducers]")
+{
+    const std::vector<int> in = { 2, 3, 5, 7, 9, 11, 12, 13, 14 };
+    const auto max = [](int lhs, int rhs) { return std::max(lhs, rhs); };
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::window<int>(3, std::plus<>{}), in),
+        matchers::elements_are(10, 15, 21, 27, 32, 36, 39));
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::window<int>(1, std::plus<>{}), in),
+        matchers::elements_are(2, 3, 5, 7, 9, 11, 12, 13, 14));
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::window<int>(10, std::plus<>{}), in),
+        matchers::is_empty());
+    const std::vector<std::string> letters = { "a", "b", "c", "d", "e" };
+    REQUIRE_THAT(  //
+        dux::into(std::vector<std::string>{}, dux::window<std::string>(3, std::plus<>{}), letters),
+        matchers::elements_are("abc", "bcd", "cde"));
+
+    std::vector<int> noise(500);
+    unsigned seed = 17;
+    for (int& x : noise)
+    {
+        seed = seed * 1103515245u + 12345u;
+        x = static_cast<int>((seed >> 16) % 1000);
+    }
+    for (const std::ptrdiff_t size : { 2, 7, 64 })
+    {
+        std::vector<int> expected;
+        for (std::size_t i = size - 1; i < noise.size(); ++i)
+        {
+            expected.push_back(*std::max_element(noise.begin() + (i - size + 1), noise.begin() + i + 1));
+        }
+        REQUIRE(  //
+            dux::into(std::vector<int>{}, dux::window<int>(size, max), noise) == expected);
+    }
+}
+
+struct collect_ints
+{
+    auto init() const -> std::vector<int>
+    {
+        return {};
+    }
+
+    void operator()(std::vector<int>& state, int x) const
+    {
+        state.push_back(x);
+    }
+};
+
+TEST_CASE("tumbling", "[transducers]")
+{
+    const std::vector<int> in = { 2, 3, 5, 7, 9, 11, 12, 13, 14 };
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::tumbling(4, 0, std::plus<>{}), in),
+        matchers::elements_are(17, 45, 14));
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::tumbling(3, 0, dux::take(2) | std::plus<>{}), in),
+        matchers::elements_are(5, 16, 25));
+    REQUIRE_THAT(  //
+        dux::into(std::vector<std::vector<int>>{}, dux::tumbling(5, collect_ints{}), in),
+        matchers::elements_are(std::vector<int>{ 2, 3, 5, 7, 9 }, std::vector<int>{ 11, 12, 13, 14 }));
+}
+
+TEST_CASE("chunk", "[transducers]")
+{
+    const auto xform = dux::chunk<int>(4)  //
+                       | dux::transform([](dux::span_t<const int> c) { return std::vector<int>(c.begin(), c.end()); });
+    const std::vector<int> in = { 2, 3, 5, 7, 9, 11, 12, 13, 14 };
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<std::vector<int>>{}, xform, in),
+        matchers::elements_are(std::vector<int>{ 2, 3, 5, 7 }, std::vector<int>{ 9, 11, 12, 13 }, std::vector<int>{ 14 }));
+
+    REQUIRE_THAT(  //
+        dux::reduce(
+            std::string{},
+            dux::chunk<int>(2)  //
+                | dux::take(2)  //
+                | dux::transform([](dux::span_t<const int> c) { return dux::reduce(0, std::plus{})(c); })
+                | delimit{ "|" })(in),
+        matchers::equal_to("5|12"));
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<std::vector<int>>{}, xform, std::vector<int>{}),
+        matchers::is_empty());
+}
+
 TEST_CASE("take_while", "[transducers]")
 {
     const auto xform = dux::take_while([](int x) { return x < 10; });
@@ -192,6 +509,21 @@ TEST_CASE("take_while", "[transducers]")
         matchers::elements_are(2, 3, 5, 7, 9));
 }
 
+TEST_CASE("take_while stops the reduction early", "[transducers]")
+{
+    std::ptrdiff_t visited = 0;
+    const auto xform = dux::inspect([&](int) { ++visited; }) | dux::take_while([](int x) { return x < 10; });
+    const std::vector<int> in = { 2, 3, 5, 7, 9, 11, 12, 13, 14 };
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, xform, in),
+        matchers::elements_are(2, 3, 5, 7, 9));
+
+    REQUIRE_THAT(  //
+        visited,
+        matchers::equal_to(6));
+}
+
 TEST_CASE("drop_while", "[transducers]")
 {
     const auto xform = dux::drop_while([](int x) { return x < 10; });
@@ -223,6 +555,21 @@ TEST_CASE("join_with", "[transducers]")
         matchers::equal_to("Alpha, Beta, Gamma"));
 }
 
+TEST_CASE("join stops the reduction early", "[transducers]")
+{
+    std::ptrdiff_t visited = 0;
+    const auto xform = dux::inspect([&](const std::string&) { ++visited; }) | dux::join | dux::take(7);
+    const std::vector<std::string> in = { "Alpha", "Beta", "Gamma" };
+
+    REQUIRE_THAT(  //
+        dux::into(std::string{}, xform, in),
+        matchers::equal_to("AlphaBe"));
+
+    REQUIRE_THAT(  //
+        visited,
+        matchers::equal_to(2));
+}
+
 TEST_CASE("intersperse", "[transducers]")
 {
     const auto xform = dux::intersperse(-1);
@@ -449,3 +796,1172 @@ TEST_CASE("fork", "[transducers]")
                         | delimit{ "" })),
         matchers::equal_to("2[30][50], 6[70][90]"));
 }
+
+TEST_CASE("fork stops when all branches are done", "[transducers]")
+{
+    std::ptrdiff_t visited = 0;
+    const std::vector<int> in = { 2, 3, 5, 6, 7, 9 };
+
+    REQUIRE_THAT(  //
+        dux::reduce(
+            std::string{},
+            dux::inspect([&](int) { ++visited; })  //
+                | dux::fork(dux::take(1) | delimit{ ", " }, dux::take(2) | delimit{ ", " }))(in),
+        matchers::equal_to("2, 2, 3"));
+
+    REQUIRE_THAT(  //
+        visited,
+        matchers::equal_to(2));
+}
+
+TEST_CASE("parallel_reduce", "[reducers]")
+{
+    dux::thread_pool pool{ 4 };
+    std::vector<int> in(100'000);
+    std::iota(in.begin(), in.end(), 0);
+
+    const auto reducer = dux::filter([](int x) { return x % 3 != 0; })  //
+                         | dux::transform([](int x) { return 2 * std::int64_t{ x }; })
+                         | std::plus{};
+
+    REQUIRE_THAT(  //
+        dux::parallel_reduce(pool, std::int64_t{ 0 }, reducer, std::plus{})(in),
+        matchers::equal_to(dux::reduce(std::int64_t{ 0 }, reducer)(in)));
+
+    REQUIRE_THAT(  //
+        in | dux::parallel_reduce(std::int64_t{ 0 }, reducer, std::plus{}),
+        matchers::equal_to(dux::reduce(std::int64_t{ 0 }, reducer)(in)));
+
+    REQUIRE_THAT(  //
+        dux::parallel_reduce(pool, std::int64_t{ 0 }, reducer, std::plus{})(std::vector<int>{}),
+        matchers::equal_to(0));
+}
+
+TEST_CASE("parallel_reduce preserves input order", "[reducers]")
+{
+    dux::thread_pool pool{ 4 };
+    std::vector<int> in1(10'000);
+    std::iota(in1.begin(), in1.end(), 0);
+    const std::vector<int> in2(in1.rbegin(), in1.rend());
+
+    const auto push_back = [](std::vector<int> total, int item)
+    {
+        total.push_back(item);
+        return total;
+    };
+    const auto concat = [](std::vector<int> lhs, const std::vector<int>& rhs)
+    {
+        lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+        return lhs;
+    };
+    const auto reducer = dux::transform([](int x, int y) { return x - y; }) | push_back;
+
+    REQUIRE(  //
+        dux::parallel_reduce(pool, std::vector<int>{}, reducer, concat)(in1, in2)
+        == dux::reduce(std::vector<int>{}, reducer)(in1, in2));
+}
+
+TEST_CASE("built reducer can be reused", "[transducers]")
+{
+    const auto reducer = dux::filter_i([](int i, int) { return i % 2 == 0; })  //
+                         | dux::take(3)                                       //
+                         | dux::transform(str)                                //
+                         | dux::intersperse(std::string{ "," })               //
+                         | delimit{ "" };
+    const std::vector<int> in = { 2, 3, 5, 7, 9, 11, 12, 13, 14 };
+
+    REQUIRE_THAT(  //
+        dux::reduce(std::string{}, reducer)(in),
+        matchers::equal_to("2,5,9"));
+
+    REQUIRE_THAT(  //
+        dux::reduce(std::string{}, reducer)(in),
+        matchers::equal_to("2,5,9"));
+
+    REQUIRE_THAT(  //
+        in | dux::reduce(std::string{}, reducer),
+        matchers::equal_to("2,5,9"));
+}
+
+TEST_CASE("built reducer can be shared between threads", "[transducers]")
+{
+    using namespace std::string_view_literals;
+    const auto reducer = dux::transform(str) | dux::join_with(", "sv) | dux::take(8) | delimit{ "" };
+    const std::vector<int> in = { 2, 3, 5, 7, 9, 11, 12, 13, 14 };
+
+    std::vector<std::string> results(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        threads.emplace_back([&, i] { results[i] = dux::reduce(std::string{}, reducer)(in); });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE_THAT(  //
+        results,
+        matchers::elements_are(
+            "2, 3, 5,", "2, 3, 5,", "2, 3, 5,", "2, 3, 5,", "2, 3, 5,", "2, 3, 5,", "2, 3, 5,", "2, 3, 5,"));
+}
+
+struct recording_vector : std::vector<int>
+{
+    std::vector<std::size_t> reserved;
+
+    void reserve(std::size_t size)
+    {
+        reserved.push_back(size);
+        std::vector<int>::reserve(size);
+    }
+};
+
+TEST_CASE("into reserves the capacity told by the chain", "[transducers]")
+{
+    const std::vector<int> in = { 2, 3, 5, 7, 9, 11, 12, 13, 14 };
+
+    const auto taken = dux::into(recording_vector{}, dux::take(3), in);
+    REQUIRE_THAT(  //
+        taken,
+        matchers::elements_are(2, 3, 5));
+    REQUIRE_THAT(  //
+        taken.reserved,
+        matchers::elements_are(3u));
+
+    const auto filtered = dux::into(recording_vector{}, dux::filter([](int x) { return x % 2 == 0; }), in);
+    REQUIRE_THAT(  //
+        filtered,
+        matchers::elements_are(2, 12, 14));
+    REQUIRE_THAT(  //
+        filtered.reserved,
+        matchers::elements_are(9u));
+
+    const auto strided = dux::into(recording_vector{}, dux::stride(4) | dux::drop(1), in);
+    REQUIRE_THAT(  //
+        strided,
+        matchers::elements_are(9, 14));
+    REQUIRE_THAT(  //
+        strided.reserved,
+        matchers::elements_are(2u));
+
+    const std::vector<std::vector<int>> nested = { { 1, 2 }, { 3 } };
+    const auto joined = dux::into(recording_vector{}, dux::join, nested);
+    REQUIRE_THAT(  //
+        joined,
+        matchers::elements_are(1, 2, 3));
+    REQUIRE_THAT(  //
+        joined.reserved,
+        matchers::is_empty());
+
+    recording_vector appended;
+    for (int i = 0; i < 5; ++i)
+    {
+        dux::into(appended, dux::take(3), in);
+    }
+    REQUIRE_THAT(  //
+        appended.size(),
+        matchers::equal_to(15u));
+    REQUIRE_THAT(  //
+        appended.reserved,
+        matchers::elements_are(3u, 6u, 12u, 24u));
+}
+
+TEST_CASE("lines and records", "[sources]")
+{
+    using namespace std::string_view_literals;
+    const auto to_string = [](std::string_view item) { return std::string{ item }; };
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<std::string>{}, dux::transform(to_string), dux::lines("ab\n\ncde\nf\n"sv)),
+        matchers::elements_are("ab", "", "cde", "f"));
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<std::string>{}, dux::transform(to_string), dux::lines("ab\ncd"sv)),
+        matchers::elements_are("ab", "cd"));
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<std::string>{}, dux::transform(to_string), dux::lines(""sv)),
+        matchers::is_empty());
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<std::string>{}, dux::transform(to_string), dux::records("abcdefghij"sv, 3)),
+        matchers::elements_are("abc", "def", "ghi"));
+
+    REQUIRE_THAT(  //
+        dux::reduce(0, [](int count, std::string_view) { return count + 1; })(dux::records("abcdefghij"sv, 0)),
+        matchers::equal_to(0));
+
+    const auto records = dux::records("abcdefghij"sv, 2);
+    auto it = records.end() - 2;
+    REQUIRE_THAT(  //
+        *it,
+        matchers::equal_to("gh"sv));
+    REQUIRE_THAT(  //
+        *(1 + (it -= 2)),
+        matchers::equal_to("ef"sv));
+    REQUIRE_THAT(  //
+        records.end() - it--,
+        matchers::equal_to(4));
+    REQUIRE(it == records.begin());
+    REQUIRE(it < records.end());
+    REQUIRE(it <= it);
+    REQUIRE(records.end() > it);
+    REQUIRE(it >= records.begin());
+}
+
+TEST_CASE("read lines and blocks from a stream", "[sources]")
+{
+    const auto to_string = [](std::string_view item) { return std::string{ item }; };
+    const std::string text = "first line\nsecond\n\na line longer than a block\nlast";
+
+    std::istringstream lines_stream{ text };
+    REQUIRE_THAT(  //
+        dux::into(
+            std::vector<std::string>{},
+            dux::filter([](std::string_view line) { return !line.empty(); }) | dux::transform(to_string),
+            dux::read_lines(lines_stream, 4)),
+        matchers::elements_are("first line", "second", "a line longer than a block", "last"));
+
+    std::istringstream blocks_stream{ text };
+    const auto blocks
+        = dux::into(std::vector<std::string>{}, dux::transform(to_string), dux::read_blocks(blocks_stream, 8));
+    REQUIRE_THAT(  //
+        blocks.size(),
+        matchers::equal_to((text.size() + 7) / 8));
+    REQUIRE_THAT(  //
+        std::accumulate(blocks.begin(), blocks.end(), std::string{}),
+        matchers::equal_to(text));
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_CASE("read a memory mapped file and a file descriptor", "[sources]")
+{
+    const auto to_string = [](std::string_view item) { return std::string{ item }; };
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ferrugo-dux-sources.test.txt";
+    {
+        std::ofstream file{ path };
+        file << "2\n3\n5\n7\n";
+    }
+
+    {
+        const dux::mapped_file file{ path.string() };
+        REQUIRE_THAT(  //
+            file.size(),
+            matchers::equal_to(8u));
+        REQUIRE_THAT(  //
+            dux::into(std::vector<std::string>{}, dux::transform(to_string), dux::lines(file)),
+            matchers::elements_are("2", "3", "5", "7"));
+    }
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    const auto parse = [](std::string_view line) { return std::stoi(std::string{ line }); };
+    REQUIRE_THAT(  //
+        dux::reduce(0, dux::transform(parse) | std::plus<>{})(dux::read_lines(fd, 3)),
+        matchers::equal_to(17));
+    ::close(fd);
+    std::filesystem::remove(path);
+}
+#endif
+
+TEST_CASE("write_to", "[reducers]")
+{
+    using namespace std::string_view_literals;
+    const std::vector<int> in = { 2, 3, 5, 7, 9, 11, 12, 13, 14 };
+
+    std::ostringstream small_buffer;
+    dux::reduce(0, dux::intersperse(", "sv) | dux::write_to(small_buffer, 4))(in);
+    REQUIRE_THAT(  //
+        small_buffer.str(),
+        matchers::equal_to("2, 3, 5, 7, 9, 11, 12, 13, 14"));
+
+    std::ostringstream large_items;
+    const std::string long_text(100, 'x');
+    dux::reduce(0, dux::transform([&](int x) { return long_text.substr(0, x); }) | dux::write_to(large_items, 8))(in);
+    REQUIRE_THAT(  //
+        large_items.str().size(),
+        matchers::equal_to(std::size_t{ 76 }));
+
+    std::ostringstream nothing;
+    dux::reduce(0, dux::write_to(nothing))(std::vector<int>{});
+    REQUIRE_THAT(  //
+        nothing.str(),
+        matchers::equal_to(""));
+
+    std::ostringstream not_completed;
+    {
+        auto run = dux::write_to(not_completed, 8).start();
+        int state = 0;
+        run(state, "abc"sv);
+        run(state, 42);
+        REQUIRE_THAT(  //
+            not_completed.str(),
+            matchers::equal_to(""));
+    }
+    REQUIRE_THAT(  //
+        not_completed.str(),
+        matchers::equal_to("abc42"));
+
+#if defined(__unix__) || defined(__APPLE__)
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ferrugo-dux-write.test.txt";
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    REQUIRE(fd >= 0);
+    dux::reduce(0, dux::transform(str) | dux::join_with("\n"sv) | dux::write_to(fd, 3))(in);
+    ::close(fd);
+
+    std::ifstream file{ path };
+    std::stringstream content;
+    content << file.rdbuf();
+    REQUIRE_THAT(  //
+        content.str(),
+        matchers::equal_to("2\n3\n5\n7\n9\n11\n12\n13\n14"));
+    std::filesystem::remove(path);
+#endif
+}
+
+struct tracked_state
+{
+    std::vector<int> items;
+    int* transfers;
+
+    explicit tracked_state(int* t) : items{}, transfers{ t }
+    {
+    }
+
+    tracked_state(const tracked_state& other) : items{ other.items }, transfers{ other.transfers }
+    {
+        ++*transfers;
+    }
+
+    tracked_state(tracked_state&& other) : items{ std::move(other.items) }, transfers{ other.transfers }
+    {
+        ++*transfers;
+    }
+
+    tracked_state& operator=(const tracked_state& other) = default;
+    tracked_state& operator=(tracked_state&& other) = default;
+};
+
+TEST_CASE("in-place reducers are not moved per item", "[reducers]")
+{
+    std::vector<int> in(1000);
+    std::iota(in.begin(), in.end(), 0);
+    int transfers = 0;
+
+    const auto reducer = dux::filter([](int x) { return x % 2 == 0; })  //
+                         | dux::transform([](int x) { return x / 2; })  //
+                         | dux::take(100)                               //
+                         | [](tracked_state& state, int x) { state.items.push_back(x); };
+
+    const tracked_state result = dux::reduce(tracked_state{ &transfers }, reducer)(in);
+
+    REQUIRE_THAT(  //
+        result.items.size(),
+        matchers::equal_to(100u));
+    REQUIRE_THAT(  //
+        result.items.back(),
+        matchers::equal_to(99));
+    REQUIRE_THAT(  //
+        transfers,
+        matchers::less_equal(3));
+}
+
+TEST_CASE("tee", "[reducers]")
+{
+    const std::vector<int> in = { 2, 3, 5, 7, 9, 11, 12, 13, 14 };
+    const auto count = [](std::size_t state, int) { return state + 1; };
+    const auto histogram = [](std::vector<int>& state, int x) { ++state[x / 5]; };
+
+    const auto [n, sum, min, max, hist] = dux::reduce(
+        std::tuple{ std::size_t{ 0 }, 0, 100, 0, std::vector<int>(3) },
+        dux::tee(count, std::plus<>{}, dux::minimum, dux::maximum, histogram))(in);
+
+    REQUIRE_THAT(  //
+        n,
+        matchers::equal_to(9u));
+    REQUIRE_THAT(  //
+        sum,
+        matchers::equal_to(76));
+    REQUIRE_THAT(  //
+        min,
+        matchers::equal_to(2));
+    REQUIRE_THAT(  //
+        max,
+        matchers::equal_to(14));
+    REQUIRE_THAT(  //
+        hist,
+        matchers::elements_are(2, 3, 4));
+
+    const auto [first, large] = dux::reduce(
+        std::tuple{ std::string{}, std::string{} },
+        dux::tee(dux::take(2) | delimit{ "," }, dux::filter([](int x) { return x > 10; }) | delimit{ ";" }))(in);
+    REQUIRE_THAT(  //
+        first,
+        matchers::equal_to("2,3"));
+    REQUIRE_THAT(  //
+        large,
+        matchers::equal_to("11;12;13;14"));
+
+    const auto [all, taken] = dux::reduce(dux::tee(bracket{}, dux::take(3) | bracket{}))(in);
+    REQUIRE_THAT(  //
+        all,
+        matchers::equal_to("[2357911121314]"));
+    REQUIRE_THAT(  //
+        taken,
+        matchers::equal_to("[235]"));
+}
+
+TEST_CASE("parallel_fork", "[reducers]")
+{
+    std::vector<int> in(100000);
+    std::iota(in.begin(), in.end(), 0);
+    const auto count = [](std::size_t state, int) { return state + 1; };
+    const auto collect = [](std::vector<int>& state, int x) { state.push_back(x); };
+
+    const auto [n, sum, max, taken, odd] = dux::reduce(
+        std::tuple{ std::size_t{ 0 }, std::int64_t{ 0 }, 0, std::string{}, std::vector<int>{} },
+        dux::parallel_fork<int>(
+            dux::batch_options{ 7, 2 },
+            count,
+            std::plus<>{},
+            dux::maximum,
+            dux::take(3) | delimit{ "," },
+            dux::filter([](int x) { return x % 2 != 0; }) | collect))(in);
+
+    REQUIRE_THAT(  //
+        n,
+        matchers::equal_to(100000u));
+    REQUIRE_THAT(  //
+        sum,
+        matchers::equal_to(std::int64_t{ 4999950000 }));
+    REQUIRE_THAT(  //
+        max,
+        matchers::equal_to(99999));
+    REQUIRE_THAT(  //
+        taken,
+        matchers::equal_to("0,1,2"));
+    REQUIRE_THAT(  //
+        odd.size(),
+        matchers::equal_to(50000u));
+    REQUIRE_THAT(  //
+        odd.back(),
+        matchers::equal_to(99999));
+
+    const auto [all, first] = dux::reduce(
+        dux::parallel_fork<int>(bracket{}, dux::take(2) | bracket{}))(std::vector<int>{ 2, 3, 5 });
+    REQUIRE_THAT(  //
+        all,
+        matchers::equal_to("[235]"));
+    REQUIRE_THAT(  //
+        first,
+        matchers::equal_to("[23]"));
+
+    const auto [empty_count, empty_sum]
+        = dux::reduce(std::tuple{ std::size_t{ 0 }, 0 }, dux::parallel_fork<int>(count, std::plus<>{}))(std::vector<int>{});
+    REQUIRE_THAT(  //
+        empty_count,
+        matchers::equal_to(0u));
+
+    const auto failing = [](int state, int x) -> int
+    {
+        if (x == 500)
+        {
+            throw std::runtime_error{ "failed" };
+        }
+        return state + x;
+    };
+    REQUIRE_THROWS_AS(
+        dux::reduce(std::tuple{ std::int64_t{ 0 }, 0 }, dux::parallel_fork<int>(std::plus<>{}, failing))(in),
+        std::runtime_error);
+}
+
+TEST_CASE("async_stage", "[transducers]")
+{
+    std::vector<int> in(100000);
+    std::iota(in.begin(), in.end(), 0);
+    const auto collect = [](std::vector<std::string>& state, std::string x) { state.push_back(std::move(x)); };
+
+    const auto xform = dux::filter([](int x) { return x % 3 == 0; })  //
+                       | dux::transform(str)                          //
+                       | dux::async_stage<std::string>(dux::batch_options{ 5, 2 })
+                       | dux::transform([](const std::string& x) { return x + "!"; });
+
+    const auto result = dux::reduce(std::vector<std::string>{}, xform | collect)(in);
+    REQUIRE_THAT(  //
+        result.size(),
+        matchers::equal_to(33334u));
+    REQUIRE_THAT(  //
+        result.back(),
+        matchers::equal_to("99999!"));
+
+    REQUIRE_THAT(  //
+        dux::reduce(dux::async_stage<int>() | dux::take(3) | bracket{})(in),
+        matchers::equal_to("[012]"));
+
+    REQUIRE_THAT(  //
+        dux::reduce(std::string{ "-" }, dux::async_stage<int>() | delimit{ "," })(std::vector<int>{}),
+        matchers::equal_to("-"));
+
+    const auto failing = [](int state, int x) -> int
+    {
+        if (x == 500)
+        {
+            throw std::runtime_error{ "failed" };
+        }
+        return state + x;
+    };
+    REQUIRE_THROWS_AS(dux::reduce(0, dux::async_stage<int>() | failing)(in), std::runtime_error);
+}
+
+struct counting_resource : std::pmr::memory_resource
+{
+    std::atomic<std::size_t> allocations{ 0 };
+
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+TEST_CASE("stages on worker threads allocate from the run context", "[transducers]")
+{
+    std::vector<int> in(1000);
+    std::iota(in.begin(), in.end(), 0);
+    const auto sum_chunk = [](int total, dux::span_t<const int> chunk)
+    { return std::accumulate(chunk.begin(), chunk.end(), total); };
+
+    counting_resource async_upstream;
+    dux::arena async_arena{ 64, &async_upstream };
+    REQUIRE_THAT(  //
+        dux::reduce(0, dux::async_stage<int>() | dux::chunk<int>(256) | sum_chunk, async_arena)(in),
+        matchers::equal_to(499500));
+    REQUIRE_THAT(  //
+        async_upstream.allocations.load(),
+        matchers::greater(0u));
+
+    counting_resource fork_upstream;
+    dux::arena fork_arena{ 64, &fork_upstream };
+    const auto [total, chunked] = dux::reduce(
+        std::tuple{ 0, 0 },
+        dux::parallel_fork<int>(std::plus<>{}, dux::chunk<int>(256) | sum_chunk),
+        fork_arena)(in);
+    REQUIRE_THAT(  //
+        chunked,
+        matchers::equal_to(total));
+    REQUIRE_THAT(  //
+        fork_upstream.allocations.load(),
+        matchers::greater(0u));
+}
+
+TEST_CASE("par_transform", "[transducers]")
+{
+    std::vector<int> in(2000);
+    std::iota(in.begin(), in.end(), 0);
+    dux::thread_pool pool{ 4 };
+
+    const auto slow_square = [](int x)
+    {
+        if (x % 97 == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds{ 200 });
+        }
+        return x * x;
+    };
+
+    const auto result = dux::into(
+        std::vector<int>{},
+        dux::filter([](int x) { return x % 2 == 0; }) | dux::par_transform<int>(pool, slow_square, 16),
+        in);
+    REQUIRE_THAT(  //
+        result.size(),
+        matchers::equal_to(1000u));
+    REQUIRE_THAT(  //
+        std::is_sorted(result.begin(), result.end()),
+        matchers::equal_to(true));
+    REQUIRE_THAT(  //
+        result.back(),
+        matchers::equal_to(1998 * 1998));
+
+    REQUIRE_THAT(  //
+        dux::reduce(dux::par_transform<int>(slow_square) | dux::take(4) | bracket{})(in),
+        matchers::equal_to("[0149]"));
+
+    const auto failing = [](int x)
+    {
+        if (x == 500)
+        {
+            throw std::runtime_error{ "failed" };
+        }
+        return x;
+    };
+    REQUIRE_THROWS_AS(dux::reduce(0, dux::par_transform<int>(pool, failing) | std::plus<>{})(in), std::runtime_error);
+}
+
+TEST_CASE("reduce zips ranges of different lengths", "[reducers]")
+{
+    const std::vector<int> a = { 1, 2, 3, 4, 5 };
+    const std::vector<double> b = { 10, 20, 30 };
+    const std::array<long, 4> c = { 100, 200, 300, 400 };
+    const auto sum_all = [](double total, int x, double y, long z) { return total + x + y + z; };
+
+    REQUIRE_THAT(  //
+        dux::reduce(0.0, sum_all)(a, b, c),
+        matchers::equal_to(666.0));
+
+    REQUIRE_THAT(  //
+        dux::reduce(0.0, dux::take(2) | sum_all)(a, b, c),
+        matchers::equal_to(333.0));
+
+    const std::list<int> d = { 1000, 2000 };
+    const auto sum_two = [](double total, int x, int y) { return total + x + y; };
+    REQUIRE_THAT(  //
+        dux::reduce(0.0, sum_two)(a, d),
+        matchers::equal_to(3003.0));
+
+    REQUIRE_THAT(  //
+        dux::reduce(0.0, sum_two)(a, std::vector<int>{}),
+        matchers::equal_to(0.0));
+}
+
+struct orders_table
+{
+    std::vector<int> quantity;
+    std::vector<double> price;
+    std::vector<std::string> customer;
+};
+
+TEST_CASE("columns", "[sources]")
+{
+    const orders_table orders = {
+        { 1, 5, 2, 8 },
+        { 2.5, 1.0, 4.0, 0.5 },
+        { "ann", "bob", "cid", "dan" },
+    };
+
+    REQUIRE_THAT(  //
+        dux::columns(orders, &orders_table::quantity, &orders_table::price)
+            | dux::reduce(
+                0.0,
+                dux::filter([](int quantity, double) { return quantity > 1; })
+                    | dux::transform([](int quantity, double price) { return quantity * price; }) | std::plus<>{}),
+        matchers::equal_to(17.0));
+
+    const auto [customers, prices] = dux::columns(orders, &orders_table::customer, &orders_table::price);
+    REQUIRE_THAT(  //
+        &customers,
+        matchers::equal_to(&orders.customer));
+    REQUIRE_THAT(  //
+        &prices,
+        matchers::equal_to(&orders.price));
+
+    const std::tuple<std::vector<int>, std::vector<char>, std::vector<int>> table
+        = { { 1, 2, 3 }, { 'a', 'b', 'c' }, { 10, 20, 30 } };
+    const int dot = dux::columns_at<2, 0>(table) | dux::reduce(0, [](int total, int x, int y) { return total + x * y; });
+    REQUIRE_THAT(  //
+        dot,
+        matchers::equal_to(140));
+}
+
+TEST_CASE("any_reducer and any_transducer", "[transducers]")
+{
+    using namespace std::string_view_literals;
+    const std::vector<int> in = { 2, 3, 5, 7, 9, 11, 12, 13, 14 };
+
+    std::vector<dux::any_transducer<int, int>> rules;
+    rules.push_back(dux::filter([](int x) { return x % 2 != 0; }));
+    rules.push_back(dux::transform([](int x) { return x * 10; }));
+    rules.push_back(dux::take(3));
+
+    dux::any_reducer<std::string, int> reducer = delimit{ "," };
+    for (auto it = rules.rbegin(); it != rules.rend(); ++it)
+    {
+        reducer = *it | reducer;
+    }
+    REQUIRE_THAT(  //
+        dux::reduce(std::string{}, reducer)(in),
+        matchers::equal_to("30,50,70"));
+
+    const dux::any_transducer<int, std::string> to_text = dux::transform(str) | dux::intersperse(std::string{ "-" });
+    const dux::any_transducer<int, std::string> chain = rules[0] | to_text;
+    REQUIRE_THAT(  //
+        dux::reduce(std::string{}, chain | dux::any_reducer<std::string, std::string>{ std::plus<>{} })(in),
+        matchers::equal_to("3-5-7-9-11-13"));
+
+    const dux::any_reducer<std::string, int> bracketed = dux::take(4) | bracket{};
+    const auto copy = bracketed;
+    REQUIRE_THAT(  //
+        dux::reduce(std::string{ "[" }, copy)(in),
+        matchers::equal_to("[2357]"));
+
+    REQUIRE_THAT(  //
+        dux::reduce(std::string{ "[" }, dux::drop(2) | bracketed)(std::list<int>(in.begin(), in.end())),
+        matchers::equal_to("[57911]"));
+
+    const dux::any_reducer<int, int> first_two = dux::take(2)(std::plus<>{});
+    static_assert(!std::is_invocable_v<decltype(first_two), int, int>);
+    auto run = first_two.start();
+    int total = 0;
+    for (int x : in)
+    {
+        run(total, x);
+    }
+    REQUIRE_THAT(  //
+        total,
+        matchers::equal_to(5));
+
+    std::array<int, 64> weights = {};
+    weights.fill(2);
+    dux::any_reducer<int, int> weighted = [weights](int total, int x) { return total + weights[0] * x; };
+    dux::any_reducer<int, int> moved = std::move(weighted);
+    REQUIRE_THAT(  //
+        dux::reduce(0, moved)(in),
+        matchers::equal_to(152));
+}
+
+struct batch_sizes
+{
+    void operator()(std::vector<std::size_t>& state, int) const
+    {
+        state.push_back(1);
+    }
+
+    void step_batch(std::vector<std::size_t>& state, dux::span_t<const int> items) const
+    {
+        state.push_back(items.size());
+    }
+};
+
+TEST_CASE("reduce over contiguous ranges steps in batches", "[transducers]")
+{
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    const std::vector<int>& in = values;
+    const auto is_even = [](int x) { return x % 2 == 0; };
+
+    // Batches reach the reducer through the stages slicing them; the other stages step their items one by one.
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<std::size_t>{}, batch_sizes{})(in),
+        matchers::elements_are(1000u));
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<std::size_t>{}, dux::drop(995) | batch_sizes{})(in),
+        matchers::elements_are(5u));
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<std::size_t>{}, dux::drop(10) | dux::take(300) | batch_sizes{})(in),
+        matchers::elements_are(300u));
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<std::size_t>{}, dux::filter(is_even) | batch_sizes{})(in).size(),
+        matchers::equal_to(500u));
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<std::size_t>{}, dux::stride(3) | dux::take(300) | batch_sizes{})(in).size(),
+        matchers::equal_to(300u));
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<std::size_t>{}, dux::take(2) | batch_sizes{})(std::list<int>{ 1, 2, 3 }),
+        matchers::elements_are(1u, 1u));
+
+    // A mutable range is batched just as well, its items reaching the reducer by mutable reference.
+    REQUIRE(
+        dux::reduce(std::vector<std::size_t>{}, batch_sizes{})(values)
+        == dux::reduce(std::vector<std::size_t>{}, batch_sizes{})(in));
+    REQUIRE(
+        dux::reduce(std::vector<std::size_t>{}, dux::drop(10) | dux::take(300) | batch_sizes{})(values)
+        == dux::reduce(std::vector<std::size_t>{}, dux::drop(10) | dux::take(300) | batch_sizes{})(in));
+
+    std::vector<int> mutable_values = { 1, 2, 3 };
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<std::size_t>{}, dux::take(2) | batch_sizes{})(mutable_values),
+        matchers::elements_are(2u));
+    REQUIRE_THAT(  //
+        dux::reduce(0, dux::take(2)([](int count, int& x) { x = 0; return count + 1; }))(mutable_values),
+        matchers::equal_to(2));
+    REQUIRE_THAT(  //
+        mutable_values,
+        matchers::elements_are(0, 0, 3));
+
+    const dux::any_transducer<int, int> skip = dux::drop(990);
+    const dux::any_transducer<int, int> first = dux::take(5);
+    const dux::any_reducer<std::vector<std::size_t>, int> sizes = batch_sizes{};
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<std::size_t>{}, skip | sizes)(in),
+        matchers::elements_are(10u));
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<std::size_t>{}, skip | first | sizes)(in),
+        matchers::elements_are(5u));
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::filter(is_even) | dux::stride(100) | dux::drop(1), in),
+        matchers::elements_are(200, 400, 600, 800));
+    REQUIRE_THAT(  //
+        dux::reduce(0, dux::filter(is_even) | dux::transform([](int x) { return x + 1; }) | dux::take(3) | std::plus<>{})(
+            in),
+        matchers::equal_to(9));
+}
+
+TEST_CASE("parallel_reduce steps contiguous slices in batches", "[reducers]")
+{
+    dux::thread_pool pool{ 4 };
+    const std::vector<int> in(4096);
+    const auto concat = [](std::vector<std::size_t> lhs, const std::vector<std::size_t>& rhs)
+    {
+        lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+        return lhs;
+    };
+
+    REQUIRE_THAT(  //
+        dux::parallel_reduce(pool, std::vector<std::size_t>{}, batch_sizes{}, concat)(in),
+        matchers::elements_are(1024u, 1024u, 1024u, 1024u));
+    REQUIRE_THAT(  //
+        dux::parallel_reduce(pool, std::vector<std::size_t>{}, dux::take(3)(batch_sizes{}), concat)(in),
+        matchers::elements_are(3u, 3u, 3u, 3u));
+}
+
+TEST_CASE("stages before take do not run ahead of it", "[transducers]")
+{
+    std::vector<int> values(1000000);
+    std::iota(values.begin(), values.end(), 0);
+    const std::vector<int>& in = values;
+    int calls = 0;
+    const auto is_even = [&calls](int x)
+    {
+        ++calls;
+        return x % 2 == 0;
+    };
+    const auto twice = [&calls](int x)
+    {
+        ++calls;
+        return 2 * x;
+    };
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::filter(is_even) | dux::take(1), in),
+        matchers::elements_are(0));
+    REQUIRE_THAT(  //
+        calls,
+        matchers::equal_to(1));
+
+    calls = 0;
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::filter(is_even) | dux::take(1), values),
+        matchers::elements_are(0));
+    REQUIRE_THAT(  //
+        calls,
+        matchers::equal_to(1));
+
+    calls = 0;
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::drop(4) | dux::filter(is_even) | dux::take(1), in),
+        matchers::elements_are(4));
+    REQUIRE_THAT(  //
+        calls,
+        matchers::equal_to(1));
+
+    calls = 0;
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::transform(twice) | dux::take(2), in),
+        matchers::elements_are(0, 2));
+    REQUIRE_THAT(  //
+        calls,
+        matchers::equal_to(2));
+}
+
+TEST_CASE("reduce with an arena", "[reducers]")
+{
+    std::vector<int> in(1000);
+    std::iota(in.begin(), in.end(), 0);
+    const auto sum_chunk = [](int total, dux::span_t<const int> chunk)
+    { return std::accumulate(chunk.begin(), chunk.end(), total); };
+
+    // Without a fallback upstream any allocation beyond the buffer throws: the runs fit in it only when every reduction
+    // gives its memory back.
+    alignas(std::max_align_t) std::byte buffer[1536];
+    dux::arena arena{ buffer, sizeof(buffer), std::pmr::null_memory_resource() };
+
+    for (int i = 0; i < 3; ++i)
+    {
+        std::ostringstream out;
+        REQUIRE_THAT(  //
+            dux::reduce(0, dux::chunk<int>(256) | sum_chunk, arena)(in),
+            matchers::equal_to(499500));
+        dux::reduce(0, dux::take(3) | dux::write_to(out, 64), arena)(in);
+        REQUIRE_THAT(  //
+            out.str(),
+            matchers::equal_to("012"));
+    }
+
+    const auto [first, second] = dux::reduce(
+        std::tuple{ 0, 0 },
+        dux::tee(
+            dux::chunk<int>(100) | sum_chunk,
+            dux::filter([](int x) { return x % 2 == 0; }) | dux::chunk<int>(100) | sum_chunk),
+        arena)(in);
+    REQUIRE_THAT(  //
+        first,
+        matchers::equal_to(499500));
+    REQUIRE_THAT(  //
+        second,
+        matchers::equal_to(249500));
+    REQUIRE_THROWS_AS(dux::reduce(0, dux::chunk<int>(1000) | sum_chunk, arena)(in), std::bad_alloc);
+}
+
+TEST_CASE("flat_map", "[containers]")
+{
+    dux::flat_map<int, int> map;
+    REQUIRE(map.empty());
+    REQUIRE(map.find(3) == map.end());
+
+    // Multiples of a power of two share their low bits, which the home slot must not depend on alone.
+    for (int i = 0; i < 5000; ++i)
+    {
+        map[i * 1024] += i;
+    }
+    const auto [it, inserted] = map.try_emplace(1024, -1);
+    REQUIRE(!inserted);
+    REQUIRE_THAT(  //
+        it->second,
+        matchers::equal_to(1));
+    REQUIRE_THAT(  //
+        map.size(),
+        matchers::equal_to(5000u));
+    REQUIRE(map.contains(4999 * 1024));
+    REQUIRE(!map.contains(1023));
+
+    std::int64_t total = 0;
+    for (const auto& [key, value] : map)
+    {
+        REQUIRE_THAT(  //
+            key,
+            matchers::equal_to(value * 1024));
+        total += value;
+    }
+    REQUIRE_THAT(  //
+        total,
+        matchers::equal_to(std::int64_t{ 4999 } * 5000 / 2));
+
+    dux::flat_map<std::string, int> reserved{ 100 };
+    const std::size_t capacity = reserved.capacity();
+    for (int i = 0; i < 100; ++i)
+    {
+        reserved.try_emplace(std::to_string(i), i);
+    }
+    REQUIRE_THAT(  //
+        reserved.capacity(),
+        matchers::equal_to(capacity));
+    REQUIRE_THAT(  //
+        reserved.find("42")->second,
+        matchers::equal_to(42));
+
+    // Hits on a table at its load limit neither grow it nor move its entries.
+    dux::flat_map<int, int> full{ 12 };
+    for (int i = 0; i < static_cast<int>(full.capacity()); ++i)
+    {
+        full[i] = i;
+    }
+    const std::size_t full_capacity = full.capacity();
+    const int* entry = &full[5];
+    full[5] += 10;
+    full.try_emplace(7, 0);
+    REQUIRE_THAT(  //
+        full.capacity(),
+        matchers::equal_to(full_capacity));
+    REQUIRE(&full.find(5)->second == entry);
+    REQUIRE_THAT(  //
+        *entry,
+        matchers::equal_to(15));
+}
+
+TEST_CASE("group_by", "[reducers]")
+{
+    const std::vector<std::string> words = { "one", "two", "three", "four", "five", "six", "seven" };
+    const auto length = [](const std::string& word) { return word.size(); };
+
+    const auto counts = dux::reduce(
+        dux::flat_map<std::size_t, int>{},
+        dux::group_by(length, [](int& count, const std::string&) { ++count; }))(words);
+    REQUIRE_THAT(  //
+        counts.size(),
+        matchers::equal_to(3u));
+    REQUIRE_THAT(  //
+        counts.find(3u)->second,
+        matchers::equal_to(3));
+    REQUIRE_THAT(  //
+        counts.find(5u)->second,
+        matchers::equal_to(2));
+
+    auto initials = dux::reduce(
+        std::unordered_map<std::size_t, std::string>{},
+        dux::group_by(length, std::string{ ">" }, [](std::string s, const std::string& word) { return s + word[0]; }))(
+        words);
+    REQUIRE_THAT(  //
+        initials[4],
+        matchers::equal_to(">ff"));
+    REQUIRE_THAT(  //
+        initials[5],
+        matchers::equal_to(">ts"));
+}
+
+TEST_CASE("group_by keeps a run per group and completes it", "[reducers]")
+{
+    const std::vector<int> in = { 9, 7, 8, 2, 5, 4, 1 };
+    const auto parity = [](int x) { return x % 2; };
+
+    const auto top = dux::reduce(dux::flat_map<int, std::vector<int>>{}, dux::group_by(parity, dux::top_k(2)))(in);
+    REQUIRE_THAT(  //
+        top.find(1)->second,
+        matchers::elements_are(9, 7));
+    REQUIRE_THAT(  //
+        top.find(0)->second,
+        matchers::elements_are(8, 4));
+
+    const auto chunk_sizes = [](std::vector<std::size_t>& sizes, dux::span_t<const int> chunk)
+    { sizes.push_back(chunk.size()); };
+    const auto chunks = dux::reduce(
+        dux::flat_map<int, std::vector<std::size_t>>{}, dux::group_by(parity, dux::chunk<int>(2) | chunk_sizes))(in);
+    REQUIRE_THAT(  //
+        chunks.find(1)->second,
+        matchers::elements_are(2u, 2u));
+    REQUIRE_THAT(  //
+        chunks.find(0)->second,
+        matchers::elements_are(2u, 1u));
+}
+
+TEST_CASE("group_by in parallel", "[reducers]")
+{
+    dux::thread_pool pool{ 4 };
+    std::vector<int> in(100000);
+    std::iota(in.begin(), in.end(), 0);
+    const auto reducer = dux::group_by([](int x) { return x % 1000; }, std::int64_t{ 0 }, std::plus<>{});
+
+    const auto expected = dux::reduce(dux::flat_map<int, std::int64_t>{ 1000 }, reducer)(in);
+    const auto actual = dux::parallel_reduce(
+        pool, dux::flat_map<int, std::int64_t>{ 1000 }, reducer, dux::merge_groups(std::plus<>{}))(in);
+
+    REQUIRE_THAT(  //
+        actual.size(),
+        matchers::equal_to(1000u));
+    for (const auto& [key, total] : expected)
+    {
+        REQUIRE_THAT(  //
+            actual.find(key)->second,
+            matchers::equal_to(total));
+    }
+}
+
+TEST_CASE("top_k and bottom_k", "[reducers]")
+{
+    const std::vector<int> in = { 5, 1, 9, 3, 7, 9, 2, 8, 6, 4 };
+
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<int>{}, dux::top_k(3))(in),
+        matchers::elements_are(9, 9, 8));
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<int>{}, dux::bottom_k(4))(in),
+        matchers::elements_are(1, 2, 3, 4));
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<int>{}, dux::top_k(20))(in),
+        matchers::elements_are(9, 9, 8, 7, 6, 5, 4, 3, 2, 1));
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<int>{}, dux::top_k(0))(in),
+        matchers::is_empty());
+
+    const std::vector<std::string> words = { "ccc", "a", "bbbb", "dd", "eeeee" };
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<std::string>{}, dux::bottom_k(2, std::less<>{}, &std::string::size))(words),
+        matchers::elements_are("a", "dd"));
+    const auto not_longest = [](const std::string& w) { return w != "eeeee"; };
+    REQUIRE_THAT(  //
+        dux::reduce(std::vector<std::string>{}, dux::filter(not_longest) | dux::top_k(1))(words),
+        matchers::elements_are("dd"));
+}
+
+TEST_CASE("top_k keeps bounded memory and merges in parallel", "[reducers]")
+{
+    std::vector<int> in(100000);
+    unsigned seed = 5;
+    for (int& x : in)
+    {
+        seed = seed * 1103515245u + 12345u;
+        x = static_cast<int>((seed >> 8) % 1000000);
+    }
+    std::vector<int> expected = in;
+    std::partial_sort(expected.begin(), expected.begin() + 100, expected.end(), std::greater<>{});
+    expected.resize(100);
+
+    const recording_vector sequential = dux::reduce(recording_vector{}, dux::top_k(100))(in);
+    REQUIRE(static_cast<const std::vector<int>&>(sequential) == expected);
+    REQUIRE_THAT(  //
+        sequential.reserved,
+        matchers::elements_are(200u));
+    REQUIRE_THAT(  //
+        sequential.capacity(),
+        matchers::equal_to(200u));
+
+    dux::thread_pool pool{ 4 };
+    const auto parallel = dux::parallel_reduce(pool, std::vector<int>{}, dux::top_k(100), dux::top_k.merge(100))(in);
+    REQUIRE(parallel == expected);
+}
+
+TEST_CASE("sort", "[transducers]")
+{
+    const std::vector<int> in = { 5, 3, 8, 1, 9, 2, 7 };
+
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::sort<int>(), in),
+        matchers::elements_are(1, 2, 3, 5, 7, 8, 9));
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::sort<int>(std::greater<>{}) | dux::take(3), in),
+        matchers::elements_are(9, 8, 7));
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::sort<int>(dux::sort_options{ 2 * sizeof(int) }) | dux::take(4), in),
+        matchers::elements_are(1, 2, 3, 5));
+    REQUIRE_THAT(  //
+        dux::into(std::vector<int>{}, dux::sort<int>(dux::sort_options{ 1 }), std::vector<int>{}),
+        matchers::is_empty());
+}
+
+TEST_CASE("sort spills runs and merges them", "[transducers]")
+{
+    std::vector<int> in(10000);
+    unsigned seed = 7;
+    for (int& x : in)
+    {
+        seed = seed * 1103515245u + 12345u;
+        x = static_cast<int>((seed >> 8) % 100000);
+    }
+    std::vector<int> expected = in;
+    std::sort(expected.begin(), expected.end());
+
+    REQUIRE(dux::into(std::vector<int>{}, dux::sort<int>(dux::sort_options{ 64 * sizeof(int) }), in) == expected);
+    REQUIRE(dux::into(std::vector<int>{}, dux::sort<int>(dux::sort_options{ 3000 * sizeof(int) }), in) == expected);
+    // 1250 runs, merged in two passes before the last merge.
+    REQUIRE(dux::into(std::vector<int>{}, dux::sort<int>(dux::sort_options{ 8 * sizeof(int) }), in) == expected);
+
+    dux::thread_pool pool{ 4 };
+    REQUIRE(dux::into(std::vector<int>{}, dux::sort<int>(dux::sort_options{ 64 * sizeof(int), &pool }), in) == expected);
+    REQUIRE(dux::into(std::vector<int>{}, dux::sort<int>(dux::sort_options{ 9000 * sizeof(int), &pool }), in) == expected);
+    REQUIRE(dux::into(std::vector<int>{}, dux::sort<int>(dux::sort_options{ 1 << 20, &pool }), in) == expected);
+
+    // Three parts merged on the pool, the merge buffer taken from an arena without fallback.
+    dux::thread_pool two_threads{ 2 };
+    alignas(std::max_align_t) static std::byte buffer[1 << 18];
+    dux::arena arena{ buffer, sizeof(buffer), std::pmr::null_memory_resource() };
+    const auto push_back = [](std::vector<int>& out, int x) { out.push_back(x); };
+    REQUIRE(
+        dux::reduce(std::vector<int>{}, dux::sort<int>(dux::sort_options{ 1 << 20, &two_threads }) | push_back, arena)(in)
+        == expected);
+
+    std::reverse(expected.begin(), expected.end());
+    REQUIRE(
+        dux::into(std::vector<int>{}, dux::sort<int>(dux::sort_options{ 100 * sizeof(int) }, std::greater<>{}), in)
+        == expected);
+}